@@ -0,0 +1,131 @@
+// Host benchmark: float vs. fixed-point orientation update (helper_3dmath.h)
+//
+//   pio run -e bench_3dmath && .pio/build/bench_3dmath/program --loops 0
+//
+// One "orientation update" is what the sketch does per DMP packet: decode the
+// quaternion, normalize it, derive gravity and rotate the accel vector into
+// the world frame. Reports host cycles per update for the float classes and
+// for QuaternionFixed/VectorFixed in Q16 and Q30, plus the worst gravity
+// error of each path against a double-precision reference.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    static inline uint64_t cycles() { return __rdtsc(); }
+    #define CYCLE_UNIT "cycles"
+#else
+    static inline uint64_t cycles() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    #define CYCLE_UNIT "ns"
+#endif
+
+#define BENCH_PACKETS   1024
+#define BENCH_ROUNDS    200
+
+static MPU6050 mpu;
+static uint8_t packets[BENCH_PACKETS][42];
+static double reference[BENCH_PACKETS][3];
+volatile float sinkFloat;
+volatile int32_t sinkFixed;
+
+static void put32(uint8_t *p, int32_t v) {
+    p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static void put16(uint8_t *p, int16_t v) {
+    p[0] = v >> 8; p[1] = v;
+}
+
+static void makePackets() {
+    randomSeed(42);
+    for (int i = 0; i < BENCH_PACKETS; i++) {
+        double q[4], m = 0;
+        for (int k = 0; k < 4; k++) {
+            q[k] = random(-100000, 100000) / 100000.0;
+            m += q[k] * q[k];
+        }
+        m = sqrt(m);
+        for (int k = 0; k < 4; k++) {
+            q[k] /= m;
+            put32(packets[i] + k * 4, (int32_t)(q[k] * 1073741823.0));
+        }
+        put16(packets[i] + 28, random(-16384, 16384));
+        put16(packets[i] + 32, random(-16384, 16384));
+        put16(packets[i] + 36, random(-16384, 16384));
+        reference[i][0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+        reference[i][1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+        reference[i][2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+    }
+}
+
+static double gravityError(int i, float x, float y, float z) {
+    double e = fabs(x - reference[i][0]);
+    e = max(e, fabs(y - reference[i][1]));
+    return max(e, fabs(z - reference[i][2]));
+}
+
+static void benchFloat() {
+    double worst = 0;
+    uint64_t t0 = cycles();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_PACKETS; i++) {
+            Quaternion q;
+            VectorInt16 raw;
+            VectorFloat gravity;
+            mpu.dmpGetQuaternion(&q, packets[i]);
+            q.normalize();
+            mpu.dmpGetGravity(&gravity, &q);
+            mpu.dmpGetAccel(&raw, packets[i]);
+            VectorFloat accel(raw.x / 16384.0f, raw.y / 16384.0f, raw.z / 16384.0f);
+            accel.rotate(&q);
+            sinkFloat = gravity.z + accel.x;
+            if (r == 0) worst = max(worst, gravityError(i, gravity.x, gravity.y, gravity.z));
+        }
+    }
+    uint64_t t1 = cycles();
+    printf("float:  %7.1f %s/update, worst gravity error %.2e\n",
+           (double)(t1 - t0) / (BENCH_ROUNDS * BENCH_PACKETS), CYCLE_UNIT, worst);
+}
+
+template <uint8_t F> static void benchFixed() {
+    double worst = 0;
+    uint64_t t0 = cycles();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_PACKETS; i++) {
+            int32_t dmp[4];
+            VectorInt16 raw;
+            mpu.dmpGetQuaternion(dmp, packets[i]);
+            QuaternionFixed<F> q(dmp);
+            q.normalize();
+            VectorFixed<F> gravity = VectorFixed<F>::getGravity(&q);
+            mpu.dmpGetAccel(&raw, packets[i]);
+            VectorFixed<F> accel((int32_t)raw.x << (F - 14), (int32_t)raw.y << (F - 14), (int32_t)raw.z << (F - 14));
+            accel.rotate(&q);
+            sinkFixed = gravity.z + accel.x;
+            if (r == 0) {
+                VectorFloat g = gravity.toFloat();
+                worst = max(worst, gravityError(i, g.x, g.y, g.z));
+            }
+        }
+    }
+    uint64_t t1 = cycles();
+    printf("Q%-2u:    %7.1f %s/update, worst gravity error %.2e\n", F,
+           (double)(t1 - t0) / (BENCH_ROUNDS * BENCH_PACKETS), CYCLE_UNIT, worst);
+}
+
+void setup() {
+    makePackets();
+    printf("orientation update, %d packets x %d rounds\n", BENCH_PACKETS, BENCH_ROUNDS);
+    benchFloat();
+    benchFixed<16>();
+    benchFixed<30>();
+}
+
+void loop() {
+}
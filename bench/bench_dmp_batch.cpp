@@ -0,0 +1,112 @@
+// Host benchmark: draining the DMP FIFO packet by packet vs. in batches
+//
+//   pio run -e bench_dmp_batch && .pio/build/bench_dmp_batch/program --loops 0
+//
+// Boots MotionApps 2.0 on the simulated MPU6050 (400 kHz virtual bus), then
+// for each drain period lets packets pile up in the FIFO and empties it two
+// ways: the classic loop (dmpPacketAvailable(), getFIFOBytes() of one packet,
+// dmpGetQuaternion/Gyro/Accel on the raw bytes) and one dmpReadPackets()
+// into a MPU6050_DMPBatch. Reports I2C transactions and bus time per packet
+// and checks both ways decoded the same sample. Virtual time, so the
+// numbers are exact and repeatable.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU6050Sim.h>
+#include <stdio.h>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#define BENCH_RUN_MS        2000
+#define BENCH_BATCH         16
+
+static MPU6050 mpu;
+
+struct Tally {
+    uint32_t packets;
+    uint32_t transactions;
+    uint32_t busMicros;
+    int32_t checksum;
+};
+
+static void begin(Tally *t) {
+    mpu.resetFIFO();
+    t->packets = 0;
+    t->checksum = 0;
+    t->transactions = Wire.transactions;
+    t->busMicros = Wire.busMicros;
+}
+
+static void end(Tally *t) {
+    t->transactions = Wire.transactions - t->transactions;
+    t->busMicros = Wire.busMicros - t->busMicros;
+}
+
+static void singles(uint16_t periodMs, Tally *t) {
+    uint8_t packet[MPU6050::PACKET_SIZE];
+    begin(t);
+    for (uint16_t ms = 0; ms < BENCH_RUN_MS; ms += periodMs) {
+        delay(periodMs);
+        while (mpu.dmpPacketAvailable()) {
+            mpu.getFIFOBytes(packet, MPU6050::PACKET_SIZE);
+            int16_t q[4];
+            VectorInt16 gyro, accel;
+            mpu.dmpGetQuaternion(q, packet);
+            mpu.dmpGetGyro(&gyro, packet);
+            mpu.dmpGetAccel(&accel, packet);
+            t->checksum += q[0] + q[1] + q[2] + q[3] + gyro.x + gyro.y + gyro.z + accel.x + accel.y + accel.z;
+            t->packets++;
+        }
+    }
+    end(t);
+}
+
+static void batches(uint16_t periodMs, Tally *t) {
+    MPU6050_DMPBatch<BENCH_BATCH> batch;
+    begin(t);
+    for (uint16_t ms = 0; ms < BENCH_RUN_MS; ms += periodMs) {
+        delay(periodMs);
+        while (mpu.dmpReadPackets(&batch) > 0) {
+            for (uint8_t i = 0; i < batch.count; i++) {
+                t->checksum += batch.quaternion[0][i] + batch.quaternion[1][i] + batch.quaternion[2][i] + batch.quaternion[3][i]
+                    + batch.gyro[0][i] + batch.gyro[1][i] + batch.gyro[2][i] + batch.accel[0][i] + batch.accel[1][i] + batch.accel[2][i];
+            }
+            t->packets += batch.count;
+            if (batch.count < BENCH_BATCH) break;
+        }
+    }
+    end(t);
+}
+
+static void report(const char *how, const Tally &t) {
+    printf("  %-8s %5u packets %6u transactions %5.2f/packet %8.2f ms bus %6.1f us/packet\n", how, t.packets,
+        t.transactions, (double)t.transactions / t.packets, t.busMicros / 1000.0, (double)t.busMicros / t.packets);
+}
+
+void setup() {
+    Wire.begin();
+    Wire.setClock(400000);
+    mpu.initialize();
+    if (mpu.dmpInitialize() != 0) {
+        printf("dmpInitialize failed\n");
+        return;
+    }
+    mpu.setDMPEnabled(true);
+
+    printf("FIFO drain, MotionApps 2.0 (%u-byte packets, %u-byte bursts), %d ms per run\n",
+        (unsigned)MPU6050::PACKET_SIZE, (unsigned)MPU6050_FIFO_BURST_SIZE, BENCH_RUN_MS);
+    static const uint16_t periods[] = { 10, 40, 80 };
+    for (uint8_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+        Tally single, batch;
+        singles(periods[i], &single);
+        batches(periods[i], &batch);
+        printf("drain every %u ms (%u packet(s) queued):\n", periods[i], periods[i] * 1000 / MPU6050_MotionApps20::INTERVAL_US);
+        report("single", single);
+        report("batch", batch);
+        // the simulated device sits still, so every packet decodes to the same sample
+        if ((int64_t)single.checksum * batch.packets != (int64_t)batch.checksum * single.packets) printf("  decoded samples differ\n");
+    }
+}
+
+void loop() {
+}
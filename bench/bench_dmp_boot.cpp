@@ -0,0 +1,83 @@
+// Host benchmark: Uno boot time to the first valid DMP quaternion
+//
+//   pio run -e bench_dmp_boot && .pio/build/bench_dmp_boot/program --loops 0
+//
+// Runs the sketch's MPU6050 bring-up (src/arduino.cpp setup()) against the
+// simulated MPU6050 on a 400 kHz virtual bus: initialize, dmpInitialize
+// (firmware upload and configuration), calibration, DMP enable, then polls
+// the FIFO until a packet decodes to a unit quaternion. Reports virtual time,
+// I2C transactions and payload bytes per phase, and the DMP memory traffic
+// of the upload. Everything is virtual time, so the numbers are exact and
+// repeatable: they are what the Uno spends on the bus, not host time.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU6050Sim.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#define BENCH_POLL_US       1000
+#define BENCH_TIMEOUT_US    1000000UL
+
+static MPU6050 mpu;
+static uint8_t fifoBuffer[64];
+
+struct Mark {
+    uint64_t micros;
+    uint32_t transactions;
+    uint32_t bytes;
+};
+
+static Mark mark() {
+    Mark m = { NativeBoard::elapsedMicros(), Wire.transactions, Wire.bytesWritten + Wire.bytesRead };
+    return m;
+}
+
+static void report(const char *phase, const Mark &from, const Mark &to) {
+    printf("%-18s %9.2f ms %6u transactions %7u bytes\n", phase, (to.micros - from.micros) / 1000.0,
+        to.transactions - from.transactions, to.bytes - from.bytes);
+}
+
+void setup() {
+    Wire.begin();
+    Wire.setClock(400000);
+
+    Mark boot = mark();
+    mpu.initialize();
+    Mark initialized = mark();
+    uint8_t status = mpu.dmpInitialize();
+    Mark uploaded = mark();
+    if (status != 0) {
+        printf("dmpInitialize failed (%u)\n", status);
+        return;
+    }
+    mpu.CalibrateAccel(6);
+    mpu.CalibrateGyro(6);
+    mpu.setDMPEnabled(true);
+    Mark enabled = mark();
+
+    bool valid = false;
+    while (!valid && NativeBoard::elapsedMicros() - enabled.micros < BENCH_TIMEOUT_US) {
+        if (mpu.dmpGetCurrentFIFOPacket(fifoBuffer)) {
+            Quaternion q;
+            mpu.dmpGetQuaternion(&q, fifoBuffer);
+            valid = fabsf(q.getMagnitude() - 1.0f) < 0.01f;
+        }
+        if (!valid) delay(BENCH_POLL_US / 1000);
+    }
+    Mark first = mark();
+
+    report("initialize", boot, initialized);
+    report("dmpInitialize", initialized, uploaded);
+    report("calibrate+enable", uploaded, enabled);
+    report("first quaternion", enabled, first);
+    report("total", boot, first);
+    printf("DMP memory: %u bytes written, %u bytes read back\n",
+        NativeMPU.memoryBytesWritten, NativeMPU.memoryBytesRead);
+    if (!valid) printf("no valid quaternion within %lu ms\n", BENCH_TIMEOUT_US / 1000);
+}
+
+void loop() {
+}
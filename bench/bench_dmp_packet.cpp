@@ -0,0 +1,175 @@
+// Host benchmark: the dmpGet*() chain vs. one lazy MPU6050::Packet per packet
+//
+//   pio run -e bench_dmp_packet && .pio/build/bench_dmp_packet/program --loops 0
+//
+// Two control cycles, each run both ways on the same random packets:
+//   heading  - the sketch: yaw only
+//   3 users  - heading (yaw/pitch/roll), a tilt guard (yaw/pitch/roll again)
+//              and telemetry (quaternion, gravity, world-frame linear accel),
+//              each calling the dmpGet*() chain on its own as the examples do
+// The chain repeats every derivation each consumer asks for, the view does
+// each once per packet. Reports host time per control cycle and, next to it,
+// the float derivations the cycle performed (quaternion, gravity, yaw,
+// pitch/roll, linear accel, vector rotation). Both are measured: the counts
+// come from the HELPER_3DMATH_COUNTING hooks in helper_3dmath.h and
+// MPU6050_DMP.h, taken in a separate pass after the timed rounds. Both ways
+// must produce identical values.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    static inline uint64_t cycles() { return __rdtsc(); }
+    #define CYCLE_UNIT "cycles"
+#else
+    static inline uint64_t cycles() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    #define CYCLE_UNIT "ns"
+#endif
+
+#define BENCH_PACKETS   1024
+#define BENCH_ROUNDS    200
+
+Helper3dmathCounts helper3dmathCounts;
+
+static MPU6050 mpu;
+static uint8_t packets[BENCH_PACKETS][MPU6050::PACKET_SIZE];
+volatile float sink;
+
+static void makePackets() {
+    randomSeed(42);
+    for (int i = 0; i < BENCH_PACKETS; i++) {
+        for (uint8_t j = 0; j < MPU6050::PACKET_SIZE; j++) packets[i][j] = random(256);
+        // a unit quaternion, so the angles are meaningful
+        float q[4], m = 0;
+        for (uint8_t k = 0; k < 4; k++) {
+            q[k] = random(-10000, 10000) / 10000.0f;
+            m += q[k] * q[k];
+        }
+        m = sqrtf(m);
+        for (uint8_t k = 0; k < 4; k++) {
+            int16_t v = (int16_t)(q[k] / m * 16383);
+            packets[i][MPU6050_MotionApps20::QUAT + 4 * k] = v >> 8;
+            packets[i][MPU6050_MotionApps20::QUAT + 4 * k + 1] = v;
+        }
+    }
+}
+
+// one consumer's yaw/pitch/roll through the chain
+static void chainYawPitchRoll(const uint8_t *packet, float *ypr) {
+    Quaternion q;
+    VectorFloat gravity;
+    mpu.dmpGetQuaternion(&q, packet);
+    mpu.dmpGetGravity(&gravity, &q);
+    mpu.dmpGetYawPitchRoll(ypr, &q, &gravity);
+}
+
+// telemetry through the chain: quaternion, gravity and world-frame linear accel
+static void chainTelemetry(const uint8_t *packet, Quaternion *q, VectorFloat *gravity, VectorInt16 *world) {
+    VectorInt16 raw, linear;
+    mpu.dmpGetQuaternion(q, packet);
+    mpu.dmpGetAccel(&raw, packet);
+    mpu.dmpGetGravity(gravity, q);
+    mpu.dmpGetLinearAccel(&linear, &raw, gravity);
+    mpu.dmpGetLinearAccelInWorld(world, &linear, q);
+}
+
+// one control cycle each way
+static void headingChain(const uint8_t *p) {
+    float ypr[3];
+    chainYawPitchRoll(p, ypr);
+    sink = ypr[0];
+}
+
+static void headingView(const uint8_t *p) {
+    MPU6050::Packet packet(p);
+    sink = packet.yaw();
+}
+
+static void usersChain(const uint8_t *p) {
+    float heading[3], tilt[3];
+    Quaternion q;
+    VectorFloat gravity;
+    VectorInt16 world;
+    chainYawPitchRoll(p, heading);
+    chainYawPitchRoll(p, tilt);
+    chainTelemetry(p, &q, &gravity, &world);
+    sink = heading[0] + tilt[1] + tilt[2] + q.w + gravity.z + world.x;
+}
+
+static void usersView(const uint8_t *p) {
+    MPU6050::Packet packet(p);
+    float heading = packet.yawPitchRoll()[0];
+    const float *tilt = packet.yawPitchRoll();
+    sink = heading + tilt[1] + tilt[2] + packet.quaternion().w + packet.gravity().z + packet.linearAccelInWorld().x;
+}
+
+// time BENCH_ROUNDS over all packets, then count one pass
+template<void (*Cycle)(const uint8_t *)>
+static void run(const char *cycle, const char *how) {
+    uint64_t t0 = cycles();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_PACKETS; i++) Cycle(packets[i]);
+    }
+    uint64_t elapsed = cycles() - t0;
+
+    memset(&helper3dmathCounts, 0, sizeof(helper3dmathCounts));
+    for (int i = 0; i < BENCH_PACKETS; i++) Cycle(packets[i]);
+    const Helper3dmathCounts &n = helper3dmathCounts;
+    printf("  %-8s %-6s %7.1f %s  %4.1f %4.1f %4.1f %4.1f %4.1f %4.1f\n", cycle, how,
+        (double)elapsed / (BENCH_ROUNDS * BENCH_PACKETS), CYCLE_UNIT,
+        (double)n.quaternion / BENCH_PACKETS, (double)n.gravity / BENCH_PACKETS, (double)n.yaw / BENCH_PACKETS,
+        (double)n.pitchRoll / BENCH_PACKETS, (double)n.linear / BENCH_PACKETS, (double)n.rotate / BENCH_PACKETS);
+}
+
+static void benchHeading() {
+    run<headingChain>("heading", "chain");
+    run<headingView>("heading", "view");
+
+    bool differ = false;
+    for (int i = 0; i < BENCH_PACKETS && !differ; i++) {
+        float ypr[3];
+        chainYawPitchRoll(packets[i], ypr);
+        MPU6050::Packet packet(packets[i]);
+        differ = ypr[0] != packet.yaw();
+    }
+    if (differ) printf("  heading: view and chain differ\n");
+}
+
+static void benchThreeUsers() {
+    run<usersChain>("3 users", "chain");
+    run<usersView>("3 users", "view");
+
+    bool differ = false;
+    for (int i = 0; i < BENCH_PACKETS && !differ; i++) {
+        float ypr[3];
+        Quaternion q;
+        VectorFloat gravity;
+        VectorInt16 world;
+        chainYawPitchRoll(packets[i], ypr);
+        chainTelemetry(packets[i], &q, &gravity, &world);
+        MPU6050::Packet packet(packets[i]);
+        differ = memcmp(ypr, packet.yawPitchRoll(), sizeof(ypr)) || q.w != packet.quaternion().w
+            || gravity.z != packet.gravity().z || world.x != packet.linearAccelInWorld().x
+            || world.y != packet.linearAccelInWorld().y || world.z != packet.linearAccelInWorld().z;
+    }
+    if (differ) printf("  3 users: view and chain differ\n");
+}
+
+void setup() {
+    makePackets();
+    printf("DMP packet consumers, %d packets x %d rounds; float derivations per cycle:\n", BENCH_PACKETS, BENCH_ROUNDS);
+    printf("  %-8s %-6s %7s %-6s  %4s %4s %4s %4s %4s %4s\n", "cycle", "way", "time", "", "quat", "grav", "yaw", "p/r",
+        "lin", "rot");
+    benchHeading();
+    benchThreeUsers();
+}
+
+void loop() {
+}
@@ -0,0 +1,66 @@
+// Host benchmark: the three DMP firmwares through MPU6050_DMP<Firmware>
+//
+//   pio run -e bench_dmp_variants && .pio/build/bench_dmp_variants/program --loops 0
+//
+// For MotionApps 2.0, 6.12 and 4.1: the flash the firmware image takes, the
+// FIFO packet size, and host cycles to decode one packet the way the sketch
+// reads it (int16 quaternion, gyro and accel). The decoders are the same
+// template instantiated with each firmware's traits, so differences in
+// cycles come from the packet layout alone. Code size per variant on the
+// Uno is what `pio run -e uno -t size` reports with that variant's header
+// included in src/arduino.cpp.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "MPU6050_DMP.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    static inline uint64_t cycles() { return __rdtsc(); }
+    #define CYCLE_UNIT "cycles"
+#else
+    static inline uint64_t cycles() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    #define CYCLE_UNIT "ns"
+#endif
+
+#define BENCH_PACKETS   1024
+#define BENCH_ROUNDS    200
+#define BENCH_PACKET_MAX 48
+
+static uint8_t packets[BENCH_PACKETS][BENCH_PACKET_MAX];
+volatile int32_t sink;
+
+template <class Firmware> static void bench(const char *name) {
+    MPU6050_DMP<Firmware> mpu;
+    uint64_t t0 = cycles();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_PACKETS; i++) {
+            int16_t q[4];
+            VectorInt16 gyro, accel;
+            mpu.dmpGetQuaternion(q, packets[i]);
+            mpu.dmpGetGyro(&gyro, packets[i]);
+            mpu.dmpGetAccel(&accel, packets[i]);
+            sink = q[0] + q[1] + q[2] + q[3] + gyro.x + gyro.y + gyro.z + accel.x + accel.y + accel.z;
+        }
+    }
+    uint64_t t1 = cycles();
+    printf("%-15s %5u B image %4u B packet %6.1f %s/packet\n", name, (unsigned)sizeof(Firmware::image),
+           (unsigned)MPU6050_DMP<Firmware>::PACKET_SIZE, (double)(t1 - t0) / (BENCH_ROUNDS * BENCH_PACKETS), CYCLE_UNIT);
+}
+
+void setup() {
+    for (int i = 0; i < BENCH_PACKETS; i++) {
+        for (int j = 0; j < BENCH_PACKET_MAX; j++) packets[i][j] = random(256);
+    }
+    printf("DMP packet decode, %d packets x %d rounds\n", BENCH_PACKETS, BENCH_ROUNDS);
+    bench<MPU6050_MotionApps20>("MotionApps 2.0");
+    bench<MPU6050_MotionApps612>("MotionApps 6.12");
+    bench<MPU6050_MotionApps41>("MotionApps 4.1");
+}
+
+void loop() {
+}
@@ -0,0 +1,103 @@
+// Host benchmark: MPU6050 DMP over I2CdevTransport instead of Wire
+//
+//   pio run -e bench_i2c_transport && .pio/build/bench_i2c_transport/program --loops 0
+//
+// Built with I2CDEV_IMPLEMENTATION = I2CDEV_TRANSPORT: I2Cdev talks to an
+// I2CdevFake bus with the simulated MPU6050 on it, so every register read is
+// one combined transaction and reads and writes go in 128-byte bursts rather
+// than the Uno's 32. Boots MotionApps 2.0 and drains the FIFO with
+// dmpReadPackets() at several periods, reporting transactions, bytes and
+// 400 kHz bus time from the transport's own counters. Compare with
+// bench_dmp_boot and bench_dmp_batch, which run the same steps over Wire.
+
+#include <Arduino.h>
+#include <MPU6050Sim.h>
+#include <I2CdevFake.h>
+#include <stdio.h>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#define BENCH_RUN_MS        2000
+#define BENCH_BATCH         16
+
+// the Wire-side MPU6050 model, seen from the fake bus
+class SimDevice : public I2CdevFakeDevice {
+    public:
+        SimDevice(I2CSlave *slave) : slave(slave) { }
+        void i2cWrite(const uint8_t *data, uint8_t length) { slave->i2cWrite(data, length); }
+        uint8_t i2cRead() { return slave->i2cRead(); }
+
+    private:
+        I2CSlave *slave;
+};
+
+// bus time advances the virtual board clock, as it does on the native Wire
+class VirtualBus : public I2CdevFake {
+    protected:
+        void elapse(uint32_t us) { NativeBoard::advanceMicros(us); }
+};
+
+static VirtualBus bus;
+static SimDevice device(&NativeMPU);
+static MPU6050 mpu(MPU6050_DEFAULT_ADDRESS, &bus);
+
+struct Mark {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t busMicros;
+};
+
+static Mark mark() {
+    Mark m = { bus.transactions, bus.bytesWritten + bus.bytesRead, bus.busMicros };
+    return m;
+}
+
+static void report(const char *phase, const Mark &from, const Mark &to) {
+    printf("%-18s %6u transactions %7u bytes %9.2f ms bus\n", phase, to.transactions - from.transactions,
+        to.bytes - from.bytes, (to.busMicros - from.busMicros) / 1000.0);
+}
+
+static void drain(uint16_t periodMs) {
+    MPU6050_DMPBatch<BENCH_BATCH> batch;
+    uint32_t packets = 0;
+    mpu.resetFIFO();
+    bus.resetStats();
+    bus.busMicros = 0;
+    for (uint16_t ms = 0; ms < BENCH_RUN_MS; ms += periodMs) {
+        delay(periodMs);
+        while (mpu.dmpReadPackets(&batch) == BENCH_BATCH) packets += BENCH_BATCH;
+        packets += batch.count;
+    }
+    printf("drain every %2u ms  %5u packets %6u transactions %5.2f/packet %6.1f us bus/packet, worst transfer %u us\n",
+        periodMs, packets, bus.transactions, (double)bus.transactions / packets,
+        (double)bus.busMicros / packets, bus.worstMicros);
+}
+
+void setup() {
+    bus.attach(MPU6050_DEFAULT_ADDRESS, &device);
+
+    Mark boot = mark();
+    mpu.initialize();
+    Mark initialized = mark();
+    uint8_t status = mpu.dmpInitialize();
+    Mark uploaded = mark();
+    if (status != 0) {
+        printf("dmpInitialize failed (%u)\n", status);
+        return;
+    }
+    mpu.setDMPEnabled(true);
+    Mark enabled = mark();
+
+    printf("MotionApps 2.0 over I2CdevFake, %u-byte bursts\n", (unsigned)I2CDEVLIB_WIRE_BUFFER_LENGTH);
+    report("initialize", boot, initialized);
+    report("dmpInitialize", initialized, uploaded);
+    report("enable", uploaded, enabled);
+    static const uint16_t periods[] = { 10, 40, 80 };
+    for (uint8_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+        drain(periods[i]);
+        if (bus.failures) printf("  %u failed transfers\n", bus.failures);
+    }
+}
+
+void loop() {
+}
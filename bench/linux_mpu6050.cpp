@@ -0,0 +1,97 @@
+// Linux host program: MPU6050 DMP on a real /dev/i2c-N adapter, no Arduino core
+//
+//   pio run -e linux_mpu6050 && .pio/build/linux_mpu6050/program [--bus N] [--seconds S] [--period-ms MS]
+//
+// For single-board computers with an MPU6050 on their I2C header. Built with
+// I2CDEV_IMPLEMENTATION = I2CDEV_TRANSPORT and without lib/ArduinoNative:
+// I2Cdev runs over I2CdevLinux (I2C_RDWR combined transactions) and the
+// device classes get time and Serial from I2CdevHost.h. Boots MotionApps
+// 2.0, then drains the FIFO with dmpReadPackets() every period for a while,
+// and reports wall time, transactions and per-transfer latency for each step.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <I2CdevLinux.h>
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#define LINUX_BATCH     16
+
+static I2CdevLinux i2c;
+
+static void report(const char *phase, uint32_t startedAt) {
+    printf("%-14s %9.2f ms %6u transactions %7u bytes, transfer mean %6.1f us worst %5u us\n", phase,
+        (micros() - startedAt) / 1000.0, i2c.transactions, i2c.bytesWritten + i2c.bytesRead,
+        i2c.transactions ? (double)i2c.transferMicros / i2c.transactions : 0.0, i2c.worstMicros);
+    i2c.resetStats();
+}
+
+int main(int argc, char **argv) {
+    unsigned bus = 1, seconds = 5, periodMs = 20;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--bus") && i + 1 < argc) bus = strtoul(argv[++i], 0, 10);
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = strtoul(argv[++i], 0, 10);
+        else if (!strcmp(argv[i], "--period-ms") && i + 1 < argc) periodMs = strtoul(argv[++i], 0, 10);
+        else {
+            fprintf(stderr, "usage: %s [--bus N] [--seconds S] [--period-ms MS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!i2c.open(bus)) {
+        fprintf(stderr, "/dev/i2c-%u: %s\n", bus, strerror(i2c.lastError));
+        return 1;
+    }
+    MPU6050 mpu(MPU6050_DEFAULT_ADDRESS, &i2c);
+
+    uint32_t t = micros();
+    mpu.initialize();
+    if (!mpu.testConnection()) {
+        fprintf(stderr, "no MPU6050 at 0x%02X on /dev/i2c-%u\n", MPU6050_DEFAULT_ADDRESS, bus);
+        return 1;
+    }
+    report("initialize", t);
+
+    t = micros();
+    uint8_t status = mpu.dmpInitialize();
+    if (status != 0) {
+        fprintf(stderr, "dmpInitialize failed (%u)\n", status);
+        return 1;
+    }
+    report("dmpInitialize", t);
+
+    t = micros();
+    mpu.CalibrateAccel(6);
+    mpu.CalibrateGyro(6);
+    mpu.setDMPEnabled(true);
+    printf("\n");
+    report("calibrate", t);
+
+    MPU6050_DMPBatch<LINUX_BATCH> batch;
+    uint32_t packets = 0;
+    float yaw = 0;
+    t = micros();
+    for (uint32_t ms = 0; ms < seconds * 1000; ms += periodMs) {
+        delay(periodMs);
+        uint8_t n;
+        while ((n = mpu.dmpReadPackets(&batch)) > 0) {
+            packets += n;
+            // newest sample's yaw, straight from its Q14 quaternion
+            uint8_t i = n - 1;
+            Quaternion q(batch.quaternion[0][i] / 16384.0f, batch.quaternion[1][i] / 16384.0f,
+                         batch.quaternion[2][i] / 16384.0f, batch.quaternion[3][i] / 16384.0f);
+            float ypr[3];
+            VectorFloat gravity;
+            MPU6050::dmpGetGravity(&gravity, &q);
+            MPU6050::dmpGetYawPitchRoll(ypr, &q, &gravity);
+            yaw = ypr[0];
+            if (n < LINUX_BATCH) break;
+        }
+    }
+    uint32_t transactions = i2c.transactions;
+    report("drain", t);
+    printf("%u packets, %.2f transactions/packet, last yaw %.1f deg\n", packets,
+        packets ? (double)transactions / packets : 0.0, yaw * 180 / PI);
+    return 0;
+}
@@ -4,13 +4,21 @@ from PyQt5.QtCore import QTimer, Qt, pyqtSlot
 from PyQt5.QtGui import QKeyEvent, QFont, QColor
 import pyqtgraph as pg
 import asyncio
+import time
 from math import cos, sin, radians
 import numpy as np
 
+from latency import now_us
+from mines import MineIndex
+from telemetry import FLAG_STALE, STREAM_POSE
+from trail import PoseTrail
+
 
 ROBOT_SPEED = 0.75  # m/s
 ROTATION_SPEED = 0.75  # rad/s
-KEYBOARD_READ_INTERVAL = 50  # ms
+KEYBOARD_READ_INTERVAL = 50  # ms, step of the local position preview per key press
+MINE_ALERT_DISTANCE = 0.3  # m, warn the operator when the robot is this close to a known mine
+KEEPALIVE_INTERVAL = 200  # ms; a moving setpoint is resent this often, the Uno stops after 500 ms without one
 MAP_SIZE = 4  # Total map size in meters (reduced from 6)
 
 class ArrowButton(QPushButton):
@@ -46,6 +54,13 @@ class MineMap(QWidget):
         super().__init__()
         self.connection = connection
         self.key_pressed = None  # Track currently pressed key
+        self.keys_held = set()  # Directions held down; combined into one setpoint
+        self.keys_changed_at = None  # latency.now_us() of the key event not yet sent, traced as the origin
+        self.setpoint = (0.0, 0.0)  # (linear, angular) wanted from the keys held
+        self.sent_setpoint = (0.0, 0.0)
+        self.sent_at = 0.0  # time.monotonic() of the last send
+        self.keepalive_due = False
+        self.send_task = None  # at most one send in flight; changes meanwhile coalesce
         
         self.setWindowTitle("Mine Detection Map")
         self.resize(800, 600)
@@ -145,6 +160,26 @@ class MineMap(QWidget):
         self.position_display = QLabel("Position: (0.00, 0.00)")
         self.position_display.setAlignment(Qt.AlignCenter)
         right_layout.addWidget(self.position_display)
+
+        # Area swept by the sensors so far
+        self.coverage_display = QLabel("Surveyed: 0.00 m²")
+        self.coverage_display.setAlignment(Qt.AlignCenter)
+        right_layout.addWidget(self.coverage_display)
+
+        # Nearest known mine, highlighted when the robot gets close
+        self.nearest_mine = QLabel("Nearest mine: none")
+        self.nearest_mine.setAlignment(Qt.AlignCenter)
+        right_layout.addWidget(self.nearest_mine)
+
+        # Command latency readout (p50/p99/max per hop, from the bridge's traces)
+        self.latency_display = QLabel("Command latency: no traces yet")
+        self.latency_display.setFont(QFont('Courier', 9))
+        right_layout.addWidget(self.latency_display)
+
+        # Receive thread counters
+        self.link_display = QLabel("Link: -")
+        self.link_display.setWordWrap(True)
+        right_layout.addWidget(self.link_display)
         
         right_layout.addStretch()
         
@@ -168,7 +203,11 @@ class MineMap(QWidget):
         # Data: robot + mines
         self.robot_pos = [0, 0]  # Center of the map (origin)
         self.robot_angle = 0  # In radians
-        self.mines = []
+        # True while the robot is placed by telemetry poses; until the first one
+        # arrives, and while odometry is stale, key presses preview the motion
+        self.pose_tracked = False
+        # Mines: repeated detections merged, indexed for nearest-mine queries
+        self.mines = MineIndex()
 
         # Plot items
         self.robot_dot = self.plot.plot([self.robot_pos[0]], [self.robot_pos[1]], 
@@ -180,55 +219,74 @@ class MineMap(QWidget):
         # Add grid lines
         self.plot.showGrid(x=True, y=True)
         
-        self.mine_dots = []
+        # Path covered so far, from the telemetry poses: one polyline item
+        self.trail = PoseTrail()
+        self.trail_line = self.plot.plot([], [], pen=pg.mkPen('#1f4e79', width=1))
+        self.trail_drawn = -1  # PoseTrail.version last drawn
+        self.pose_position = 0  # read position in the connection's pose ring
+        self.poses_lost = 0
+
+        # All mine markers are one scatter item; update_gui appends only the
+        # mines added since the last frame, and redraws all only when a merge moved one
+        self.mine_scatter = pg.ScatterPlotItem(pen=None, symbol='x', brush='red', size=15)
+        self.plot.addItem(self.mine_scatter)
+        self.mines_drawn = 0
 
         # Timer to refresh display
         self.timer = QTimer()
         self.timer.timeout.connect(self.update_gui)
         self.timer.start(100)  # ms
         
-        # Timer to send direction commands
-        self.command_timer = QTimer()
-        self.command_timer.timeout.connect(self.send_direction)
-        self.command_timer.start(KEYBOARD_READ_INTERVAL)
+        # Key events send setpoint changes straight away; this timer only keeps
+        # a moving robot alive (deadman: it stops if the client goes quiet)
+        self.keepalive_timer = QTimer()
+        self.keepalive_timer.timeout.connect(self.send_keepalive)
+        self.keepalive_timer.start(KEEPALIVE_INTERVAL)
     
     def place_mine_at_robot(self):
-        """Place a mine marker at the current robot position"""
+        """Place a mine marker at the robot's telemetry pose (the key-press
+        preview while there is no fresh pose; see update_gui)"""
         x, y = self.robot_pos[0], self.robot_pos[1]
         self.add_mine(x, y)
         self.mine_status.setText(f"Last mine added: ({x:.2f}, {y:.2f})")
-        self.mine_count.setText(f"Total mines: {len(self.mines)}")
-        print(f"Mine added at robot position: ({x:.2f}, {y:.2f})")
+        self.mine_count.setText(f"Total mines: {len(self.mines)} ({self.mines.detections} detections)")
     
     def keyPressEvent(self, event: QKeyEvent):
         prev_key = self.key_pressed
+        held = set(self.keys_held)
         
         if event.key() == Qt.Key_W:
             self.key_pressed = "forward"
+            self.keys_held.add("forward")
             self.forward_btn.set_active(True)
             new_x = self.robot_pos[0] + ROBOT_SPEED*cos(self.robot_angle)*KEYBOARD_READ_INTERVAL/1000
             new_y = self.robot_pos[1] + ROBOT_SPEED*sin(self.robot_angle)*KEYBOARD_READ_INTERVAL/1000
             # Check map boundaries (-2 to 2 range)
-            if -2 <= new_x <= 2 and -2 <= new_y <= 2:
+            if not self.pose_tracked and -2 <= new_x <= 2 and -2 <= new_y <= 2:
                 self.robot_pos[0] = new_x
                 self.robot_pos[1] = new_y
         elif event.key() == Qt.Key_S:
             self.key_pressed = "backward"
+            self.keys_held.add("backward")
             self.backward_btn.set_active(True)
             new_x = self.robot_pos[0] - ROBOT_SPEED*cos(self.robot_angle)*KEYBOARD_READ_INTERVAL/1000
             new_y = self.robot_pos[1] - ROBOT_SPEED*sin(self.robot_angle)*KEYBOARD_READ_INTERVAL/1000
             # Check map boundaries (-2 to 2 range)
-            if -2 <= new_x <= 2 and -2 <= new_y <= 2:
+            if not self.pose_tracked and -2 <= new_x <= 2 and -2 <= new_y <= 2:
                 self.robot_pos[0] = new_x
                 self.robot_pos[1] = new_y
         elif event.key() == Qt.Key_A:
             self.key_pressed = "left"
+            self.keys_held.add("left")
             self.left_btn.set_active(True)
-            self.robot_angle += (ROTATION_SPEED * (KEYBOARD_READ_INTERVAL / 1000))
+            if not self.pose_tracked:
+                self.robot_angle += (ROTATION_SPEED * (KEYBOARD_READ_INTERVAL / 1000))
         elif event.key() == Qt.Key_D: 
             self.key_pressed = "right"
+            self.keys_held.add("right")
             self.right_btn.set_active(True)
-            self.robot_angle -= (ROTATION_SPEED * (KEYBOARD_READ_INTERVAL / 1000))
+            if not self.pose_tracked:
+                self.robot_angle -= (ROTATION_SPEED * (KEYBOARD_READ_INTERVAL / 1000))
         elif event.key() == Qt.Key_M:
             # Add mine at robot position when M is pressed
             self.place_mine_at_robot()
@@ -239,11 +297,20 @@ class MineMap(QWidget):
         while self.robot_angle < 0:
             self.robot_angle += 2*np.pi
             
+        if self.keys_held != held:
+            self.keys_changed_at = now_us()
+            self.update_setpoint()
+
         self.update_robot_position(self.robot_pos[0], self.robot_pos[1])
-        print(f"Position: ({self.robot_pos[0]:.2f}, {self.robot_pos[1]:.2f}), Angle: {self.robot_angle:.2f} rad")
-        print(f"Command: {self.key_pressed}")
 
     def keyReleaseEvent(self, event: QKeyEvent):
+        if not event.isAutoRepeat():
+            held = len(self.keys_held)
+            self.keys_held.discard({Qt.Key_W: "forward", Qt.Key_S: "backward",
+                                    Qt.Key_A: "left", Qt.Key_D: "right"}.get(event.key()))
+            if len(self.keys_held) != held:
+                self.keys_changed_at = now_us()
+                self.update_setpoint()
         # Only clear if this key was the active one
         if event.key() == Qt.Key_W and self.key_pressed == "forward":
             self.key_pressed = None
@@ -258,12 +325,64 @@ class MineMap(QWidget):
             self.key_pressed = None
             self.right_btn.set_active(False)
 
-    def send_direction(self):
-        if self.connection and self.connection.is_websocket_open.is_set():
-            direction = self.key_pressed if self.key_pressed else "none"
-            asyncio.create_task(self.connection.send_data({"cmd": direction}))
+    def update_setpoint(self):
+        """Combine the keys held into one setpoint and send it if it changed."""
+        # W+A drives an arc instead of alternating between the two
+        held = self.keys_held
+        linear = ROBOT_SPEED * (("forward" in held) - ("backward" in held))
+        angular = ROTATION_SPEED * (("left" in held) - ("right" in held))
+        self.setpoint = (linear, angular)
+        self.schedule_send()
+
+    def send_keepalive(self):
+        # Stopped needs no keepalive: the Uno stops on its own without one
+        if self.setpoint != (0.0, 0.0) and time.monotonic() - self.sent_at >= KEEPALIVE_INTERVAL / 2000:
+            self.keepalive_due = True
+            self.schedule_send()
+
+    def schedule_send(self):
+        if self.send_task is None or self.send_task.done():
+            self.send_task = asyncio.create_task(self.send_setpoints())
+
+    async def send_setpoints(self):
+        """Send until the bridge has the newest setpoint. Changes made while a
+        send is in flight are picked up by the next pass, so a burst of key
+        events costs one message per pass, never a queue of stale ones."""
+        while self.connection and self.connection.is_websocket_open.is_set():
+            if self.setpoint == self.sent_setpoint and not self.keepalive_due:
+                break
+            setpoint, origin = self.setpoint, self.keys_changed_at
+            self.keys_changed_at = None
+            self.keepalive_due = False
+            self.sent_setpoint = setpoint
+            self.sent_at = time.monotonic()
+            await self.connection.send_setpoint(*setpoint, origin)
 
     def update_gui(self):
+        if self.connection:
+            self.latency_display.setText(self.connection.latency.readout())
+            self.link_display.setText(f"{self.connection.counters()}, {self.poses_lost} poses lost")
+
+            # Poses decoded by the receive thread since the last frame
+            poses, self.pose_position, lost = self.connection.rings[STREAM_POSE].read(self.pose_position)
+            self.poses_lost += lost
+            trail = self.trail
+            trail.extend(poses["x"], poses["y"])
+
+            # The newest pose places the robot, so it stays on its own trail
+            if len(poses):
+                pose = poses[-1]
+                self.pose_tracked = not pose["flags"] & FLAG_STALE
+                if self.pose_tracked:
+                    self.update_robot_position(float(pose["x"]), float(pose["y"]), float(pose["heading"]))
+
+            # Redraw the trail only when it grew; polyline() is bounded in size
+            if trail.version != self.trail_drawn:
+                points = trail.polyline()
+                self.trail_line.setData(points[:, 0], points[:, 1])
+                self.trail_drawn = trail.version
+                self.coverage_display.setText(f"Surveyed: {trail.covered_area():.2f} m²")
+
         # Update robot position
         self.robot_dot.setData([self.robot_pos[0]], [self.robot_pos[1]])
         
@@ -279,18 +398,28 @@ class MineMap(QWidget):
         # Update position display
         self.position_display.setText(f"Position: ({self.robot_pos[0]:.2f}, {self.robot_pos[1]:.2f})")
 
-        # Clear old mine markers
-        for dot in self.mine_dots:
-            self.plot.removeItem(dot)
-        self.mine_dots.clear()
+        # Draw new mine markers, if any
+        mines = self.mines
+        if mines.moved:
+            self.mine_scatter.setData(pos=mines.xy[:len(mines)])
+            mines.moved = False
+            self.mines_drawn = len(mines)
+        elif self.mines_drawn < len(mines):
+            self.mine_scatter.addPoints(pos=mines.xy[self.mines_drawn:len(mines)])
+            self.mines_drawn = len(mines)
 
-        # Redraw mine markers
-        for (x, y) in self.mines:
-            dot = self.plot.plot([x], [y], pen=None, symbol='x', symbolBrush='red', symbolSize=15)
-            self.mine_dots.append(dot)
+        # robot_pos was just set from the newest pose, so the alert follows the real robot
+        index, distance = mines.nearest(*self.robot_pos)
+        if index is None:
+            self.nearest_mine.setText("Nearest mine: none")
+        else:
+            self.nearest_mine.setText(f"Nearest mine: {distance:.2f} m ({mines.counts[index]} detections)")
+        self.nearest_mine.setStyleSheet("color: red;" if distance <= MINE_ALERT_DISTANCE else "")
 
-    def update_robot_position(self, x, y):
+    def update_robot_position(self, x, y, angle=None):
         self.robot_pos = [x, y]
+        if angle is not None:
+            self.robot_angle = angle
 
     def add_mine(self, x, y):
-        self.mines.append((x, y))
\ No newline at end of file
+        self.mines.add(x, y)
\ No newline at end of file
@@ -0,0 +1,95 @@
+"""End-to-end latency of drive commands, from key press to motor PWM.
+
+Every setpoint the client sends carries an 8-bit id and the client's clock at
+the key press behind it (origin). Once the Uno has written the setpoint to the
+motors, the bridge echoes both in a trace frame with the time each hop on its
+side took (see include/telemetry.h). CommandLatency pairs traces with the
+commands it sent and keeps recent samples per hop:
+
+    client  key press -> command handed to the WebSocket
+    wifi    WebSocket -> bridge, one way: half of the round trip left over
+            after the bridge, UART and Uno hops
+    bridge  command received -> setpoint written to the UART
+    uart    bridge -> Uno, one way
+    uno     setpoint received -> motor PWM written
+    total   key press -> motor PWM, the sum of the above
+
+Times are in milliseconds. The wifi and uart hops are estimates: each side
+only has its own clock, so a one-way time is half a round trip.
+"""
+import time
+
+import numpy as np
+
+HOPS = ("client", "wifi", "bridge", "uart", "uno", "total")
+SAMPLES = 1000  # per hop, newest kept
+
+
+def now_us() -> int:
+    """Client clock for command origins: monotonic microseconds, wrapping like the bridge's."""
+    return (time.perf_counter_ns() // 1000) & 0xFFFFFFFF
+
+
+class CommandLatency:
+    def __init__(self, samples: int = SAMPLES):
+        self.samples = np.zeros((len(HOPS), samples), dtype=np.float32)
+        self.count = 0
+        self.next_id = 0
+        self.sent = {}          # command id -> (origin, sent), client clock in us
+        self.unmatched = 0      # traces for commands no longer remembered
+
+    def command(self, origin: int = None) -> tuple:
+        """Id and origin for the next command; origin defaults to now (no key press behind it)."""
+        command_id = self.next_id
+        self.next_id = (self.next_id + 1) & 0xFF
+        origin = now_us() if origin is None else origin & 0xFFFFFFFF
+        self.sent[command_id] = (origin, now_us())
+        return command_id, origin
+
+    def add(self, trace) -> None:
+        """Record one trace record (telemetry.TRACE_DTYPE)."""
+        entry = self.sent.pop(int(trace["id"]), None)
+        if entry is None or entry[0] != int(trace["origin"]):
+            self.unmatched += 1
+            return
+        origin, sent = entry
+        received = now_us()
+        bridge, uart, uno = (int(trace[hop]) for hop in ("bridge", "uart", "uno"))
+        client = (sent - origin) & 0xFFFFFFFF
+        round_trip = (received - sent) & 0xFFFFFFFF
+        wifi = max(0, round_trip - bridge - 2 * uart - uno) / 2
+        hops = (client, wifi, bridge, uart, uno, client + wifi + bridge + uart + uno)
+        self.samples[:, self.count % self.samples.shape[1]] = np.array(hops) / 1000
+        self.count += 1
+
+    def summary(self) -> dict:
+        """{hop: (p50, p99, max)} in ms over the recent samples; empty before the first trace."""
+        n = min(self.count, self.samples.shape[1])
+        if not n:
+            return {}
+        recent = self.samples[:, :n]
+        p50, p99 = np.percentile(recent, (50, 99), axis=1)
+        worst = recent.max(axis=1)
+        return {hop: (float(p50[i]), float(p99[i]), float(worst[i])) for i, hop in enumerate(HOPS)}
+
+    def histogram(self, hop: str = "total", bins: int = 20) -> tuple:
+        """Counts and bin edges (ms) of one hop's recent samples, as numpy.histogram returns them."""
+        n = min(self.count, self.samples.shape[1])
+        return np.histogram(self.samples[HOPS.index(hop), :n], bins=bins)
+
+    def worst_hop(self) -> str:
+        """Hop with the highest p99, the one to fix first; None before the first trace."""
+        summary = self.summary()
+        hops = [hop for hop in HOPS if hop != "total"]
+        return max(hops, key=lambda hop: summary[hop][1]) if summary else None
+
+    def readout(self) -> str:
+        summary = self.summary()
+        if not summary:
+            return "Command latency: no traces yet"
+        lines = ["Command latency, ms (p50 / p99 / max)"]
+        for hop in HOPS:
+            p50, p99, worst = summary[hop]
+            lines.append(f"{hop:>6}: {p50:5.1f} / {p99:5.1f} / {worst:5.1f}")
+        lines.append(f"worst hop: {self.worst_hop()}")
+        return "\n".join(lines)
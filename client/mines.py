@@ -0,0 +1,119 @@
+"""Mine map: detections merged into distinct mines, indexed for proximity queries.
+
+A detection within merge_radius of a known mine is the same mine seen again:
+it moves the mine to the mean of its detections and raises its count (the
+confidence). Anything further away is a new mine. Mines live in numpy arrays
+(xy, counts) so the GUI can draw them without copying, and in a grid hash of
+merge_radius cells. A merge then only looks at the 3x3 cells around a
+detection, and radius and nearest-neighbour queries only at the cells they
+can reach, whatever the size of the map.
+"""
+import math
+
+import numpy as np
+
+MERGE_RADIUS = 0.15  # m, detections closer than this to a mine are that mine
+CAPACITY = 1024  # initial storage; doubles when full
+
+
+class MineIndex:
+    def __init__(self, merge_radius: float = MERGE_RADIUS, capacity: int = CAPACITY):
+        self.merge_radius = merge_radius
+        self.cell = merge_radius
+        self.xy = np.empty((capacity, 2), dtype=np.float64)  # first `total` rows in use
+        self.counts = np.empty(capacity, dtype=np.int32)  # detections merged into each mine
+        self.total = 0
+        self.detections = 0
+        self.grid = {}  # (column, row) -> list of mine indices
+        self.moved = False  # a known mine changed since the consumer last cleared this
+
+    def __len__(self):
+        return self.total
+
+    def _key(self, x: float, y: float) -> tuple:
+        return (math.floor(x / self.cell), math.floor(y / self.cell))
+
+    def _candidates(self, key: tuple, reach: int) -> list:
+        column, row = key
+        found = []
+        for i in range(column - reach, column + reach + 1):
+            for j in range(row - reach, row + reach + 1):
+                found.extend(self.grid.get((i, j), ()))
+        return found
+
+    def add(self, x: float, y: float) -> int:
+        """Record a detection; returns the index of the mine it was merged into or created."""
+        self.detections += 1
+        key = self._key(x, y)
+        nearest, nearest_distance = None, self.merge_radius
+        for index in self._candidates(key, 1):
+            distance = math.hypot(self.xy[index, 0] - x, self.xy[index, 1] - y)
+            if distance <= nearest_distance:
+                nearest, nearest_distance = index, distance
+        if nearest is not None:
+            self._merge(nearest, x, y)
+            return nearest
+
+        if self.total == len(self.xy):
+            self.xy = np.concatenate((self.xy, np.empty_like(self.xy)))
+            self.counts = np.concatenate((self.counts, np.empty_like(self.counts)))
+        index = self.total
+        self.xy[index] = (x, y)
+        self.counts[index] = 1
+        self.total += 1
+        self.grid.setdefault(key, []).append(index)
+        return index
+
+    def _merge(self, index: int, x: float, y: float) -> None:
+        old_key = self._key(*self.xy[index])
+        self.counts[index] += 1
+        self.xy[index] += (np.array((x, y)) - self.xy[index]) / self.counts[index]
+        new_key = self._key(*self.xy[index])
+        if new_key != old_key:
+            cell = self.grid[old_key]
+            cell.remove(index)
+            if not cell:
+                del self.grid[old_key]
+            self.grid.setdefault(new_key, []).append(index)
+        self.moved = True
+
+    def within(self, x: float, y: float, radius: float) -> np.ndarray:
+        """Indices of the mines within radius of (x, y), nearest first."""
+        if not self.total:
+            return np.empty(0, dtype=np.intp)
+        reach = math.ceil(radius / self.cell)
+        if (2 * reach + 1) ** 2 > len(self.grid):
+            candidates = np.arange(self.total)
+        else:
+            candidates = np.array(self._candidates(self._key(x, y), reach), dtype=np.intp)
+        distances = np.hypot(self.xy[candidates, 0] - x, self.xy[candidates, 1] - y)
+        inside = distances <= radius
+        return candidates[inside][np.argsort(distances[inside])]
+
+    def nearest(self, x: float, y: float) -> tuple:
+        """(index, distance) of the mine nearest to (x, y); (None, inf) on an empty map.
+
+        Searches rings of cells outwards. Once a mine is found no closer than
+        the rings already searched reach, nothing further out can beat it. A
+        sparse map is searched in one vectorised pass instead.
+        """
+        if not self.total:
+            return None, math.inf
+        column, row = self._key(x, y)
+        best, best_distance = None, math.inf
+        ring = 0
+        while (2 * ring + 1) ** 2 <= len(self.grid):
+            for i in range(column - ring, column + ring + 1):
+                for j in range(row - ring, row + ring + 1):
+                    if max(abs(i - column), abs(j - row)) != ring:
+                        continue
+                    for index in self.grid.get((i, j), ()):
+                        distance = math.hypot(self.xy[index, 0] - x, self.xy[index, 1] - y)
+                        if distance < best_distance:
+                            best, best_distance = index, distance
+            if best_distance <= ring * self.cell:
+                return best, best_distance
+            ring += 1
+        distances = np.hypot(self.xy[:self.total, 0] - x, self.xy[:self.total, 1] - y)
+        best = int(np.argmin(distances))
+        return best, float(distances[best])
@@ -1,61 +1,158 @@
+"""WebSocket connection to the bridge, run on a thread of its own.
+
+The thread owns the socket and its own asyncio loop. It decodes every message
+as it arrives into one RecordRing of typed records per stream, so decoding
+never waits behind, or holds up, the Qt event loop. The GUI reads what is new
+from the rings once per frame. Replies to requests (format, rates, tasks,
+clients) land in plain attributes. Nothing on the receive path prints: see
+the counters instead.
+
+The async send methods are called from the GUI's loop and hand the message
+over to the receive thread's loop, which owns the socket.
+"""
 import asyncio
-import websockets
 import json
+import threading
+
+import websockets
+
+import telemetry
+from latency import CommandLatency
+from ring import RecordRing
+
+RING_CAPACITY = 4096  # records per stream; several seconds at the highest rates
 
 
 class Connection:
     def __init__(self, esp_ip, esp_port):
         self.uri = f"ws://{esp_ip}:{esp_port}"
-        self.data_queue = asyncio.Queue()
-        self.is_websocket_open = asyncio.Event()
+        self.is_websocket_open = asyncio.Event()  # set on the caller's loop by run()
+        self.telemetry_format = "json"  # until the bridge confirms binary
+        self.rings = [RecordRing(dtype, RING_CAPACITY) for dtype in telemetry.STREAM_DTYPES]
+        self.stream_rates = {}          # Hz per stream name, as confirmed by the bridge
+        self.uno_tasks = []             # Uno scheduler statistics, after request_tasks()
+        self.bridge_clients = []        # per-client telemetry queues on the bridge, after request_clients()
+        self.latency = CommandLatency() # per-hop drive command latency, from the bridge's trace frames
+
+        # counters, written by the receive thread only
+        self.messages_received = 0
+        self.bytes_received = 0
+        self.frames_received = 0
+        self.bad_messages = 0           # undecodable, wrong magic or version, unknown stream
+        self.send_errors = 0
+
+        self.websocket = None
+        self.loop = None                # the receive thread's loop, once connected
+
+    @property
+    def latest(self) -> dict:
+        """Newest record per stream (telemetry.STREAM_*), streams received so far only."""
+        return {stream: ring.latest() for stream, ring in enumerate(self.rings) if ring.head}
 
-    async def __connect(self):
+    def counters(self) -> str:
+        return (f"Link: {self.messages_received} messages, {self.frames_received} frames, "
+                f"{self.bytes_received // 1024} KB, {self.bad_messages} bad")
+
+    async def run(self):
+        """Connect on the receive thread and wait, on the caller's loop, until the connection ends."""
+        caller = asyncio.get_running_loop()
+        done = asyncio.Event()
+
+        def receive_thread():
+            try:
+                asyncio.run(self.__receive(caller))
+            finally:
+                caller.call_soon_threadsafe(self.is_websocket_open.clear)
+                caller.call_soon_threadsafe(done.set)
+
+        threading.Thread(target=receive_thread, name="telemetry", daemon=True).start()
+        await done.wait()
+
+    async def __receive(self, caller):
         self.websocket = await websockets.connect(self.uri)
+        self.loop = asyncio.get_running_loop()
         print(f"Connected to {self.uri}")
-        self.is_websocket_open.set()
-
-    async def __receive_data(self):
+        await self.websocket.send(json.dumps(telemetry.NEGOTIATE))
+        caller.call_soon_threadsafe(self.is_websocket_open.set)
         try:
-            async for request in self.websocket:
-                # print(f"Request received: {request}")
-                self.data_queue.put_nowait(request)
+            async for message in self.websocket:
+                self.__ingest(message)
         except websockets.exceptions.ConnectionClosed:
-            print("Websocket was closed")
+            pass
+        finally:
+            self.loop = None
             await self.websocket.close()
+            print("Websocket was closed")
+
+    def __ingest(self, message):
+        self.messages_received += 1
+        self.bytes_received += len(message)
+        try:
+            if isinstance(message, bytes):
+                frames = telemetry.decode(message)
+            else:
+                reply = json.loads(message)
+                if self.__reply(reply):
+                    return
+                frames = telemetry.from_json(reply)
+        except (ValueError, json.JSONDecodeError):
+            self.bad_messages += 1
             return
-        except asyncio.CancelledError:
-            print("Handler task was cancelled")
-            return
+        for stream, records in telemetry.split(frames).items():
+            self.rings[stream].push(records)
+            if stream == telemetry.STREAM_TRACE:
+                for trace in records:
+                    self.latency.add(trace)
+        self.frames_received += len(frames)
 
-    async def __process_data (self):
-        while True:
-            try:
-                data = await self.data_queue.get()
-                print(f"Processing data: {data}")
-            except asyncio.CancelledError:
-                print("Data processing task was cancelled")
-                break
+    def __reply(self, message: dict) -> bool:
+        """Take in the answer to a request; False for JSON telemetry."""
+        if "format" in message:
+            self.telemetry_format = message["format"]
+            print(f"Telemetry format: {self.telemetry_format} v{message.get('version')}")
+        elif "tasks" in message:
+            self.uno_tasks = message["tasks"]
+        elif "clients" in message and "stream" not in message:
+            self.bridge_clients = message["clients"]
+        elif "hz" in message:
+            self.stream_rates[message["stream"]] = message["hz"]
+        else:
+            return False
+        return True
 
-    async def send_data(self, data: dict):
+    async def __send(self, message):
         try:
-            data_str = json.dumps(data)
-            await self.websocket.send(data_str)
+            await self.websocket.send(message)
         except websockets.exceptions.ConnectionClosed:
-            print("Websocket was closed")
-            await self.websocket.close()
-            return
-        except asyncio.CancelledError:
-            print("Handler task was cancelled")
+            self.send_errors += 1
+
+    async def __submit(self, message):
+        """Send from the caller's loop through the receive thread's loop."""
+        loop = self.loop
+        if loop is None:
+            self.send_errors += 1
             return
+        await asyncio.wrap_future(asyncio.run_coroutine_threadsafe(self.__send(message), loop))
 
-    async def run(self):
-        await self.__connect()
-        receive_task = asyncio.create_task(self.__receive_data())
-        process_task = asyncio.create_task(self.__process_data())
+    async def send_data(self, data: dict):
+        await self.__submit(json.dumps(data))
 
-        try:
-            await asyncio.gather(receive_task, process_task)
-        except asyncio.CancelledError:
-            print("Run task was cancelled")
-        finally:
-            await self.websocket.close()
+    async def send_setpoint(self, linear: float, angular: float, origin: int = None):
+        """Drive the robot at linear m/s and angular rad/s (the Uno ramps to them).
+
+        origin is latency.now_us() at the key press behind the command, if any; it is traced.
+        """
+        command_id, origin = self.latency.command(origin)
+        await self.__submit(telemetry.setpoint(linear, angular, command_id, origin))
+
+    async def request_tasks(self):
+        """Ask for the Uno's per-task run counts, worst-case execution times and overruns."""
+        await self.send_data({"tasks": 1})
+
+    async def request_clients(self):
+        """Ask for every connected client's rates, queue depth, sent and dropped frames and send time blocked."""
+        await self.send_data({"clients": 1})
+
+    async def set_rate(self, stream: str, hz: int):
+        """Change a telemetry stream's rate for this client only (0 turns it off)."""
+        await self.send_data(telemetry.rate_request(stream, hz))
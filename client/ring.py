@@ -0,0 +1,57 @@
+"""Single-producer, single-consumer ring of typed numpy records, without locks.
+
+The receive thread pushes decoded telemetry frames; the GUI reads whatever is
+new once per frame. The writer first reserves the slots it is about to
+overwrite, copies the records in, then publishes them by advancing head (plain
+int stores, atomic under the GIL). A reader keeps its own position, copies
+what lies between it and head, then checks the reservation again: records the
+writer may have been overwriting meanwhile are dropped and counted as lost
+instead of being returned torn. Readers never block the writer.
+"""
+import numpy as np
+
+
+class RecordRing:
+    def __init__(self, dtype: np.dtype, capacity: int):
+        self.records = np.zeros(capacity, dtype=dtype)
+        self.head = 0  # records published, ever
+        self.reserved = 0  # records being written, ever; >= head
+
+    def __len__(self):
+        return min(self.head, len(self.records))
+
+    def push(self, records: np.ndarray) -> None:
+        """Append records (writer thread only). More than fit keeps the newest."""
+        capacity = len(self.records)
+        count = len(records)
+        end = self.head + count
+        if count > capacity:
+            records = records[-capacity:]
+        self.reserved = end
+        start = (end - len(records)) % capacity
+        first = min(len(records), capacity - start)
+        self.records[start:start + first] = records[:first]
+        self.records[:len(records) - first] = records[first:]
+        self.head = end
+
+    def read(self, position: int) -> tuple:
+        """Records published after position: (records, new position, records lost).
+
+        Start with position 0; pass the returned position back next time.
+        Records lost were overwritten before this reader got to them.
+        """
+        capacity = len(self.records)
+        head = self.head
+        start = max(position, head - capacity)
+        records = self.records[np.arange(start, head) % capacity]
+        lost = start - position
+        torn = min(max(0, self.reserved - capacity - start), len(records))
+        if torn:
+            records = records[torn:]
+            lost += torn
+        return records, head, lost
+
+    def latest(self):
+        """Newest record, or None before the first push."""
+        head = self.head
+        return self.records[(head - 1) % len(self.records)].copy() if head else None
@@ -0,0 +1,145 @@
+"""Decoder for the bridge's telemetry frames (see include/telemetry.h).
+
+A binary WebSocket message is one or more 32-byte little-endian frames back to
+back: a common header followed by a stream-specific payload. decode() views
+the whole message as a numpy record array without copying, and split() gives
+a typed view per stream. HEADER unpacks a single frame header with struct.
+JSON telemetry (the fallback format) is converted to the same record layout by
+from_json(), so callers handle both formats the same way. setpoint() builds the
+binary drive command the client sends the other way; the bridge answers each
+one with a trace frame (see latency.py).
+"""
+import struct
+import numpy as np
+
+MAGIC = 0xA5
+VERSION = 3
+
+STREAM_POSE = 0
+STREAM_SENSORS = 1
+STREAM_HEALTH = 2
+STREAM_TRACE = 3  # sent per drive command, not sampled
+STREAM_NAMES = ("pose", "sensors", "health", "trace")
+
+FLAG_MINE = 0x01
+FLAG_MOVING = 0x02  # pose, sensors: the last setpoint sent to the Uno is not a stop
+FLAG_STALE = 0x04  # pose: no odometry from the Uno recently
+
+RANGES = 3  # front, left, right; mm, 0 = no echo
+
+HEADER = struct.Struct("<BBBBII")
+_HEADER_FIELDS = [
+    ("magic", "u1"),
+    ("version", "u1"),
+    ("stream", "u1"),
+    ("flags", "u1"),
+    ("seq", "<u4"),        # per stream
+    ("timestamp", "<u4"),  # us since bridge boot, wraps
+]
+FRAME_DTYPE = np.dtype(_HEADER_FIELDS + [("payload", "V20")])
+POSE_DTYPE = np.dtype(_HEADER_FIELDS + [
+    ("x", "<f4"),          # m
+    ("y", "<f4"),          # m
+    ("heading", "<f4"),    # rad
+    ("reserved", "V8"),
+])
+SENSORS_DTYPE = np.dtype(_HEADER_FIELDS + [
+    ("range", "<u2", (RANGES,)),
+    ("reserved", "V14"),
+])
+HEALTH_DTYPE = np.dtype(_HEADER_FIELDS + [
+    ("free_heap", "<u4"),
+    ("loops_per_second", "<u4"),
+    ("dropped", "<u4"),
+    ("batch", "<u2"),
+    ("clients", "u1"),
+    ("reserved", "V5"),
+])
+TRACE_DTYPE = np.dtype(_HEADER_FIELDS + [
+    ("origin", "<u4"),     # client clock at the key press, us; echoed from the command
+    ("id", "u1"),          # command id, echoed
+    ("reserved0", "u1"),
+    ("bridge", "<u2"),     # us, command received -> setpoint written to the UART
+    ("uart", "<u2"),       # us, bridge -> Uno, one way
+    ("uno", "<u2"),        # us, setpoint received -> motor PWM written
+    ("reserved", "V8"),
+])
+STREAM_DTYPES = (POSE_DTYPE, SENSORS_DTYPE, HEALTH_DTYPE, TRACE_DTYPE)
+assert HEADER.size == 12
+assert all(dtype.itemsize == FRAME_DTYPE.itemsize == 32 for dtype in STREAM_DTYPES)
+
+# sent once after connecting; the bridge replies {"format": ..., "version": ...}
+NEGOTIATE = {"format": "binary", "version": VERSION}
+
+COMMAND_MAGIC = 0x5A
+COMMAND_SETPOINT = 1
+COMMAND = struct.Struct("<BBBBhhI")  # magic, version, type, id, linear mm/s, angular mrad/s, origin us
+assert COMMAND.size == 12
+
+
+def decode(message: bytes) -> np.ndarray:
+    """View a binary message as an array of frames (read-only, no copy)."""
+    if not message or len(message) % FRAME_DTYPE.itemsize:
+        raise ValueError(f"telemetry message of {len(message)} bytes is not a whole number of frames")
+    frames = np.frombuffer(message, dtype=FRAME_DTYPE)
+    if (frames["magic"] != MAGIC).any() or (frames["version"] != VERSION).any():
+        raise ValueError("telemetry frame with unknown magic or version")
+    return frames
+
+
+def split(frames: np.ndarray) -> dict:
+    """Typed per-stream views of decoded frames: {stream: array}, streams present only."""
+    if len(frames) and (frames["stream"] == frames["stream"][0]).all():
+        stream = int(frames["stream"][0])
+        return {stream: frames.view(STREAM_DTYPES[stream])} if stream < len(STREAM_DTYPES) else {}
+    return {stream: frames[frames["stream"] == stream].view(dtype)
+            for stream, dtype in enumerate(STREAM_DTYPES)
+            if (frames["stream"] == stream).any()}
+
+
+def rate_request(stream: str, hz: int) -> dict:
+    """Message that sets a stream's rate; the bridge replies with the rate applied."""
+    return {"stream": stream, "hz": int(hz)}
+
+
+def setpoint(linear: float, angular: float, command_id: int = 0, origin: int = 0) -> bytes:
+    """Drive command: linear velocity in m/s and angular velocity in rad/s (counter-clockwise positive).
+
+    command_id (8 bits) and origin (client clock in us, 32 bits) come back in the trace frame.
+    """
+    def clamp(value):
+        return max(-32768, min(32767, round(value * 1000)))
+    return COMMAND.pack(COMMAND_MAGIC, VERSION, COMMAND_SETPOINT, command_id & 0xFF,
+                        clamp(linear), clamp(angular), origin & 0xFFFFFFFF)
+
+
+def from_json(message: dict) -> np.ndarray:
+    """Build a one-frame array, typed for its stream, from a JSON telemetry sample."""
+    stream = STREAM_NAMES.index(message.get("stream", "pose"))
+    frames = np.zeros(1, dtype=STREAM_DTYPES[stream])
+    frame = frames[0]
+    frame["magic"] = MAGIC
+    frame["version"] = VERSION
+    frame["stream"] = stream
+    frame["seq"] = message.get("seq", 0)
+    frame["timestamp"] = message.get("t", 0)
+    if stream == STREAM_POSE:
+        frame["x"] = message.get("x", 0.0)
+        frame["y"] = message.get("y", 0.0)
+        frame["heading"] = message.get("heading", 0.0)
+    elif stream == STREAM_SENSORS:
+        frame["flags"] = FLAG_MINE if message.get("mine") else 0
+        frame["range"] = (message.get("front", 0), message.get("left", 0), message.get("right", 0))
+    elif stream == STREAM_TRACE:
+        frame["origin"] = message.get("origin", 0)
+        frame["id"] = message.get("id", 0)
+        frame["bridge"] = message.get("bridge", 0)
+        frame["uart"] = message.get("uart", 0)
+        frame["uno"] = message.get("uno", 0)
+    else:
+        frame["free_heap"] = message.get("heap", 0)
+        frame["loops_per_second"] = message.get("lps", 0)
+        frame["dropped"] = message.get("dropped", 0)
+        frame["batch"] = message.get("batch", 0)
+        frame["clients"] = message.get("clients", 0)
+    return frames
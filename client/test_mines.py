@@ -0,0 +1,100 @@
+"""Tests for mines.MineIndex: merging, the grid hash and proximity queries.
+
+    cd client && python -m unittest
+"""
+import math
+import random
+import unittest
+
+import numpy as np
+
+from mines import MineIndex
+
+
+def brute_nearest(index, x, y):
+    distances = np.hypot(index.xy[:index.total, 0] - x, index.xy[:index.total, 1] - y)
+    return float(distances.min())
+
+
+def brute_within(index, x, y, radius):
+    distances = np.hypot(index.xy[:index.total, 0] - x, index.xy[:index.total, 1] - y)
+    return set(np.flatnonzero(distances <= radius))
+
+
+class MineIndexTest(unittest.TestCase):
+    def test_empty_map(self):
+        mines = MineIndex()
+        self.assertEqual(mines.nearest(1.0, 2.0), (None, math.inf))
+        self.assertEqual(len(mines.within(1.0, 2.0, 10.0)), 0)
+
+    def test_detections_within_the_radius_merge(self):
+        mines = MineIndex(merge_radius=0.15)
+        first = mines.add(1.0, 1.0)
+        self.assertEqual(mines.add(1.1, 1.0), first)
+        self.assertEqual(mines.add(1.05, 1.05), first)
+        self.assertEqual(len(mines), 1)
+        self.assertEqual(mines.detections, 3)
+        self.assertEqual(mines.counts[first], 3)
+        np.testing.assert_allclose(mines.xy[first], (1.05, 1.0166666), atol=1e-6)
+        self.assertTrue(mines.moved)
+
+    def test_detections_beyond_the_radius_are_new_mines(self):
+        mines = MineIndex(merge_radius=0.15)
+        self.assertEqual(mines.add(0.0, 0.0), 0)
+        self.assertEqual(mines.add(0.16, 0.0), 1)
+        self.assertEqual(mines.add(0.0, -0.2), 2)
+        self.assertEqual(len(mines), 3)
+        self.assertFalse(mines.moved)
+
+    def test_merge_joins_the_nearest_mine(self):
+        mines = MineIndex(merge_radius=0.15)
+        mines.add(0.0, 0.0)
+        mines.add(0.2, 0.0)
+        self.assertEqual(mines.add(0.12, 0.0), 1)
+
+    def test_merge_moves_a_mine_into_another_cell(self):
+        mines = MineIndex(merge_radius=0.15)
+        index = mines.add(0.14, 0.0)  # cell (0, 0)
+        mines.add(0.2, 0.0)  # mean 0.17: cell (1, 0)
+        self.assertNotIn((0, 0), mines.grid)
+        self.assertEqual(mines.grid[(1, 0)], [index])
+        self.assertEqual(mines.nearest(0.3, 0.0)[0], index)
+        self.assertEqual(list(mines.within(0.3, 0.0, 0.14)), [index])
+
+    def test_storage_grows_past_capacity(self):
+        mines = MineIndex(merge_radius=0.15, capacity=4)
+        for i in range(10):
+            self.assertEqual(mines.add(i * 1.0, 0.0), i)
+        self.assertEqual(len(mines), 10)
+        self.assertGreaterEqual(len(mines.xy), 10)
+        np.testing.assert_array_equal(mines.xy[:10, 0], np.arange(10.0))
+        np.testing.assert_array_equal(mines.counts[:10], 1)
+
+    def test_within_is_sorted_nearest_first(self):
+        mines = MineIndex(merge_radius=0.15)
+        for x in (0.9, 0.3, 2.0, 0.6, -0.5):
+            mines.add(x, 0.0)
+        found = mines.within(0.0, 0.0, 1.0)
+        self.assertEqual([float(mines.xy[i, 0]) for i in found], [0.3, -0.5, 0.6, 0.9])
+
+    def test_queries_match_brute_force(self):
+        rng = random.Random(7)
+        # sparse (few cells, vectorised pass) and dense (ring search) maps
+        for count, extent in ((5, 20.0), (40, 2.0), (400, 5.0), (2000, 30.0)):
+            mines = MineIndex(merge_radius=0.15, capacity=64)
+            for _ in range(count):
+                mines.add(rng.uniform(-extent, extent), rng.uniform(-extent, extent))
+            for _ in range(200):
+                x, y = rng.uniform(-1.5 * extent, 1.5 * extent), rng.uniform(-1.5 * extent, 1.5 * extent)
+                index, distance = mines.nearest(x, y)
+                self.assertAlmostEqual(distance, brute_nearest(mines, x, y), places=9)
+                self.assertAlmostEqual(distance, math.hypot(mines.xy[index, 0] - x, mines.xy[index, 1] - y),
+                                       places=9)
+                radius = rng.uniform(0.0, 2.0)
+                found = mines.within(x, y, radius)
+                self.assertEqual(set(found), brute_within(mines, x, y, radius))
+                self.assertEqual(len(found), len(set(found)))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,103 @@
+"""Tests for ring.RecordRing: wrap, overwrite accounting and torn reads.
+
+    cd client && python -m unittest
+"""
+import unittest
+
+import numpy as np
+
+from ring import RecordRing
+
+DTYPE = np.dtype([("seq", "<u4"), ("value", "<f4")])
+
+
+def records(first, count):
+    out = np.zeros(count, dtype=DTYPE)
+    out["seq"] = np.arange(first, first + count)
+    out["value"] = out["seq"] * 0.5
+    return out
+
+
+class RecordRingTest(unittest.TestCase):
+    def test_empty(self):
+        ring = RecordRing(DTYPE, 8)
+        self.assertEqual(len(ring), 0)
+        self.assertIsNone(ring.latest())
+        got, position, lost = ring.read(0)
+        self.assertEqual((len(got), position, lost), (0, 0, 0))
+
+    def test_reads_only_what_is_new(self):
+        ring = RecordRing(DTYPE, 8)
+        ring.push(records(0, 3))
+        got, position, lost = ring.read(0)
+        self.assertEqual(list(got["seq"]), [0, 1, 2])
+        self.assertEqual((position, lost), (3, 0))
+        ring.push(records(3, 2))
+        got, position, lost = ring.read(position)
+        self.assertEqual(list(got["seq"]), [3, 4])
+        self.assertEqual((position, lost), (5, 0))
+        got, position, lost = ring.read(position)
+        self.assertEqual((len(got), position, lost), (0, 5, 0))
+
+    def test_push_wraps_around_the_end(self):
+        ring = RecordRing(DTYPE, 8)
+        ring.push(records(0, 6))
+        _, position, _ = ring.read(0)
+        ring.push(records(6, 5))  # slots 6, 7, 0, 1, 2
+        got, position, lost = ring.read(position)
+        self.assertEqual(list(got["seq"]), [6, 7, 8, 9, 10])
+        self.assertEqual((position, lost), (11, 0))
+        self.assertEqual(len(ring), 8)
+        np.testing.assert_array_equal(got["value"], got["seq"] * 0.5)
+
+    def test_slow_reader_counts_overwritten_records_as_lost(self):
+        ring = RecordRing(DTYPE, 8)
+        for first in range(0, 20, 4):
+            ring.push(records(first, 4))
+        got, position, lost = ring.read(0)
+        self.assertEqual(list(got["seq"]), list(range(12, 20)))
+        self.assertEqual((position, lost), (20, 12))
+
+    def test_push_of_more_than_capacity_keeps_the_newest(self):
+        ring = RecordRing(DTYPE, 8)
+        ring.push(records(0, 3))
+        ring.push(records(3, 21))
+        self.assertEqual(ring.head, 24)
+        self.assertEqual(len(ring), 8)
+        got, position, lost = ring.read(3)
+        self.assertEqual(list(got["seq"]), list(range(16, 24)))
+        self.assertEqual((position, lost), (24, 13))
+        self.assertEqual(int(ring.latest()["seq"]), 23)
+
+    def test_records_being_overwritten_are_not_returned(self):
+        ring = RecordRing(DTYPE, 8)
+        ring.push(records(0, 8))
+        # the writer has reserved three more slots (0, 1, 2) but not yet published them
+        ring.reserved = ring.head + 3
+        ring.records[:3] = records(100, 3)  # half-written
+        got, position, lost = ring.read(0)
+        self.assertEqual(list(got["seq"]), [3, 4, 5, 6, 7])
+        self.assertEqual((position, lost), (8, 3))
+
+    def test_reservation_beyond_the_unread_records_drops_them_all(self):
+        ring = RecordRing(DTYPE, 8)
+        ring.push(records(0, 8))
+        _, position, _ = ring.read(0)
+        ring.push(records(8, 2))
+        ring.reserved = ring.head + 8  # a full ring's worth in flight
+        got, position, lost = ring.read(position)
+        self.assertEqual(len(got), 0)
+        self.assertEqual((position, lost), (10, 2))
+
+    def test_latest_is_a_copy(self):
+        ring = RecordRing(DTYPE, 4)
+        ring.push(records(0, 6))
+        newest = ring.latest()
+        self.assertEqual(int(newest["seq"]), 5)
+        ring.push(records(6, 4))
+        self.assertEqual(int(newest["seq"]), 5)
+        self.assertEqual(int(ring.latest()["seq"]), 9)
+
+
+if __name__ == "__main__":
+    unittest.main()
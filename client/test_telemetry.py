@@ -0,0 +1,117 @@
+"""Tests for telemetry: binary frames, rejected messages and the JSON fallback.
+
+    cd client && python -m unittest
+"""
+import struct
+import unittest
+
+import numpy as np
+
+import telemetry as t
+
+
+def frame(stream, payload, flags=0, seq=0, timestamp=0, magic=t.MAGIC, version=t.VERSION):
+    """One frame packed field by field as include/telemetry.h lays it out."""
+    return t.HEADER.pack(magic, version, stream, flags, seq, timestamp) + payload.ljust(20, b"\0")
+
+
+def pose(x, y, heading, **header):
+    return frame(t.STREAM_POSE, struct.pack("<fff", x, y, heading), **header)
+
+
+def sensors(front, left, right, **header):
+    return frame(t.STREAM_SENSORS, struct.pack("<HHH", front, left, right), **header)
+
+
+class DecodeTest(unittest.TestCase):
+    def test_pose_fields(self):
+        frames = t.decode(pose(1.5, -2.25, 0.5, flags=t.FLAG_MOVING, seq=7, timestamp=0xFFFFFFFF))
+        views = t.split(frames)
+        self.assertEqual(list(views), [t.STREAM_POSE])
+        p = views[t.STREAM_POSE][0]
+        self.assertEqual((float(p["x"]), float(p["y"]), float(p["heading"])), (1.5, -2.25, 0.5))
+        self.assertEqual((int(p["flags"]), int(p["seq"]), int(p["timestamp"])), (t.FLAG_MOVING, 7, 0xFFFFFFFF))
+
+    def test_sensors_fields(self):
+        s = t.split(t.decode(sensors(400, 0, 65535, flags=t.FLAG_MINE)))[t.STREAM_SENSORS][0]
+        self.assertEqual(list(s["range"]), [400, 0, 65535])
+        self.assertTrue(s["flags"] & t.FLAG_MINE)
+
+    def test_health_and_trace_fields(self):
+        health = frame(t.STREAM_HEALTH, struct.pack("<IIIHB", 30000, 5000, 12, 8, 2))
+        trace = frame(t.STREAM_TRACE, struct.pack("<IBBHHH", 123456, 9, 0, 300, 700, 1500))
+        views = t.split(t.decode(health + trace))
+        h = views[t.STREAM_HEALTH][0]
+        self.assertEqual((int(h["free_heap"]), int(h["loops_per_second"]), int(h["dropped"]),
+                          int(h["batch"]), int(h["clients"])), (30000, 5000, 12, 8, 2))
+        r = views[t.STREAM_TRACE][0]
+        self.assertEqual((int(r["origin"]), int(r["id"]), int(r["bridge"]), int(r["uart"]), int(r["uno"])),
+                         (123456, 9, 300, 700, 1500))
+
+    def test_mixed_message_is_split_per_stream_in_order(self):
+        message = pose(1, 0, 0, seq=1) + sensors(1, 2, 3, seq=1) + pose(2, 0, 0, seq=2) + pose(3, 0, 0, seq=3)
+        views = t.split(t.decode(message))
+        self.assertEqual(sorted(views), [t.STREAM_POSE, t.STREAM_SENSORS])
+        self.assertEqual(list(views[t.STREAM_POSE]["x"]), [1.0, 2.0, 3.0])
+        self.assertEqual(list(views[t.STREAM_POSE]["seq"]), [1, 2, 3])
+        self.assertEqual(len(views[t.STREAM_SENSORS]), 1)
+
+    def test_unknown_stream_is_ignored(self):
+        self.assertEqual(t.split(t.decode(frame(len(t.STREAM_DTYPES), b""))), {})
+        views = t.split(t.decode(frame(len(t.STREAM_DTYPES), b"") + pose(1, 0, 0)))
+        self.assertEqual(list(views), [t.STREAM_POSE])
+
+    def test_decode_does_not_copy(self):
+        message = bytearray(pose(1, 0, 0))
+        frames = t.decode(message)
+        message[12:16] = struct.pack("<f", 4.0)
+        self.assertEqual(float(t.split(frames)[t.STREAM_POSE][0]["x"]), 4.0)
+
+    def test_bad_magic_version_or_length_is_rejected(self):
+        good = pose(1, 0, 0)
+        for message in (b"",
+                        good[:-1],
+                        good + good[:12],
+                        good + pose(1, 0, 0, magic=0x5A),
+                        pose(1, 0, 0, version=t.VERSION - 1)):
+            with self.assertRaises(ValueError):
+                t.decode(message)
+
+
+class JsonTest(unittest.TestCase):
+    def test_pose(self):
+        f = t.from_json({"stream": "pose", "seq": 4, "t": 99, "x": 0.5, "y": -1.0, "heading": 3.0})
+        self.assertEqual(f.dtype, t.POSE_DTYPE)
+        self.assertEqual((int(f[0]["magic"]), int(f[0]["version"]), int(f[0]["seq"]), int(f[0]["timestamp"])),
+                         (t.MAGIC, t.VERSION, 4, 99))
+        self.assertEqual((float(f[0]["x"]), float(f[0]["y"]), float(f[0]["heading"])), (0.5, -1.0, 3.0))
+
+    def test_stream_defaults_to_pose(self):
+        self.assertEqual(t.from_json({"x": 1.0}).dtype, t.POSE_DTYPE)
+
+    def test_sensors_mine_flag(self):
+        f = t.from_json({"stream": "sensors", "front": 10, "left": 20, "right": 30, "mine": True})
+        self.assertEqual(list(f[0]["range"]), [10, 20, 30])
+        self.assertEqual(int(f[0]["flags"]), t.FLAG_MINE)
+        self.assertEqual(int(t.from_json({"stream": "sensors"})[0]["flags"]), 0)
+
+    def test_json_and_binary_frames_match(self):
+        binary = t.split(t.decode(sensors(10, 20, 30, flags=t.FLAG_MINE, seq=5, timestamp=6)))[t.STREAM_SENSORS]
+        json = t.from_json({"stream": "sensors", "seq": 5, "t": 6, "front": 10, "left": 20, "right": 30,
+                            "mine": 1})
+        self.assertEqual(binary.tobytes(), json.tobytes())
+
+    def test_unknown_stream_is_rejected(self):
+        with self.assertRaises(ValueError):
+            t.from_json({"stream": "battery"})
+
+
+class SetpointTest(unittest.TestCase):
+    def test_layout_and_clamping(self):
+        command = t.setpoint(0.25, -100.0, command_id=0x1FF, origin=-1)
+        self.assertEqual(t.COMMAND.unpack(command),
+                         (t.COMMAND_MAGIC, t.VERSION, t.COMMAND_SETPOINT, 0xFF, 250, -32768, 0xFFFFFFFF))
+
+
+if __name__ == "__main__":
+    unittest.main()
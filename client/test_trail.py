@@ -0,0 +1,61 @@
+"""Tests for trail.PoseTrail: decimation and the coverage grid.
+
+    cd client && python -m unittest
+"""
+import unittest
+
+from trail import PoseTrail
+
+
+class PoseTrailTest(unittest.TestCase):
+    def test_standing_still_adds_nothing(self):
+        trail = PoseTrail()
+        trail.extend([0.0] * 100, [0.0] * 100)
+        self.assertEqual(len(trail.polyline()), 1)
+        self.assertEqual(trail.version, 1)
+
+    def test_levels_are_decimated(self):
+        trail = PoseTrail(step=0.01, levels=3, capacity=1024)
+        xs = [i * 0.0125 for i in range(1, 201)]  # 2.5 m in 1.25 cm steps
+        trail.extend(xs, [0.0] * len(xs))
+        self.assertEqual([len(ring) for ring in trail.levels], [200, 50, 13])
+
+    def test_polyline_fits_the_budget(self):
+        trail = PoseTrail(step=0.01, levels=2, capacity=4096)
+        xs = [i * 0.0125 for i in range(1, 3001)]
+        trail.extend(xs, [0.0] * len(xs))
+        self.assertLessEqual(len(trail.polyline(max_points=1000)), 1000)
+        self.assertEqual(len(trail.polyline(max_points=5000)), 3000)
+
+    def test_ring_wraps_to_the_newest_points(self):
+        trail = PoseTrail(step=0.01, levels=1, capacity=8)
+        xs = [i * 0.0125 for i in range(1, 21)]
+        trail.extend(xs, [0.0] * len(xs))
+        line = trail.polyline()
+        self.assertEqual(len(line), 8)
+        self.assertAlmostEqual(float(line[0, 0]), 13 * 0.0125, places=5)
+        self.assertAlmostEqual(float(line[-1, 0]), 20 * 0.0125, places=5)
+
+    def test_pose_outside_the_extent_covers_nothing(self):
+        trail = PoseTrail(swath=0.0, cell=0.1, extent=1.0)
+        trail.add(-1.05, 0.0)  # half a cell below -extent: truncation would put it in cell 0
+        self.assertEqual(trail.covered_area(), 0.0)
+        trail.add(-0.95, 0.0)
+        self.assertAlmostEqual(trail.covered_area(), 0.01)
+        self.assertTrue(trail.covered[0, 10])
+
+    def test_coverage_includes_the_far_corner_cell(self):
+        trail = PoseTrail(swath=0.0, cell=0.1, extent=1.0)
+        trail.add(0.55, 0.55)  # cell (15, 15)
+        self.assertEqual(trail.coverage(0.55, 0.55, 0.55, 0.55), 1.0)
+        self.assertAlmostEqual(trail.coverage(0.45, 0.45, 0.55, 0.55), 0.25)
+        self.assertAlmostEqual(trail.coverage(0.55, 0.55, 0.45, 0.45), 0.25)
+
+    def test_coverage_outside_the_grid_is_zero(self):
+        trail = PoseTrail(cell=0.1, extent=1.0)
+        trail.add(0.0, 0.0)
+        self.assertEqual(trail.coverage(5.0, 5.0, 6.0, 6.0), 0.0)
+
+
+if __name__ == "__main__":
+    unittest.main()
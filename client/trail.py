@@ -0,0 +1,115 @@
+"""Pose trail: where the robot has been, in fixed memory, drawable in constant time.
+
+Poses from telemetry go through a min-distance filter into a stack of ring
+buffers, one per level of detail. Level k keeps a pose only once the robot
+has moved STEP * SPREAD**k from the last pose kept there, so a robot standing
+still adds nothing and coarser levels hold longer stretches of the run.
+polyline() returns the finest level whose points fit the draw budget (all of
+it if the run is short, the coarsest level's newest points otherwise), so the
+GUI draws one polyline of bounded size however long the survey runs.
+
+Coverage is a boolean grid over a fixed extent: every pose kept on the finest
+level marks the cells within half the sensor swath of it.
+"""
+import math
+
+import numpy as np
+
+STEP = 0.01  # m, finest level spacing
+SPREAD = 4  # spacing ratio between levels
+LEVELS = 4  # 1, 4, 16, 64 cm
+CAPACITY = 1 << 16  # poses per level
+DRAW_MAX = 5000  # points per polyline
+
+COVERAGE_CELL = 0.05  # m
+COVERAGE_EXTENT = 10.0  # m, the grid spans -extent..extent on both axes
+SWATH = 0.2  # m, width the sensors cover
+
+
+class Ring:
+    def __init__(self, capacity: int):
+        self.xy = np.zeros((capacity, 2), dtype=np.float32)
+        self.total = 0  # ever added; the newest min(total, capacity) are kept
+
+    def __len__(self):
+        return min(self.total, len(self.xy))
+
+    def append(self, x: float, y: float) -> None:
+        self.xy[self.total % len(self.xy)] = (x, y)
+        self.total += 1
+
+    def last(self) -> np.ndarray:
+        return self.xy[(self.total - 1) % len(self.xy)]
+
+    def ordered(self) -> np.ndarray:
+        """Kept points, oldest first (a copy only once the ring has wrapped)."""
+        if self.total <= len(self.xy):
+            return self.xy[:self.total]
+        start = self.total % len(self.xy)
+        return np.concatenate((self.xy[start:], self.xy[:start]))
+
+
+class PoseTrail:
+    def __init__(self, step: float = STEP, levels: int = LEVELS, capacity: int = CAPACITY,
+                 swath: float = SWATH, cell: float = COVERAGE_CELL, extent: float = COVERAGE_EXTENT):
+        self.steps = [step * SPREAD ** level for level in range(levels)]
+        self.levels = [Ring(capacity) for _ in range(levels)]
+        self.version = 0  # bumped whenever the finest level changes; redraw when it differs
+
+        self.cell = cell
+        self.extent = extent
+        cells = int(round(2 * extent / cell))
+        self.covered = np.zeros((cells, cells), dtype=bool)
+        reach = int(math.ceil(swath / 2 / cell))
+        offsets = np.arange(-reach, reach + 1)
+        i, j = np.meshgrid(offsets, offsets, indexing="ij")
+        inside = np.hypot(i, j) * cell <= swath / 2
+        self.stencil = (i[inside], j[inside])  # cells of the swath disc around a pose
+
+    def extend(self, xs, ys) -> None:
+        """Add poses (m), oldest first."""
+        for x, y in zip(np.asarray(xs, dtype=np.float64), np.asarray(ys, dtype=np.float64)):
+            self.add(x, y)
+
+    def add(self, x: float, y: float) -> None:
+        for level, (ring, step) in enumerate(zip(self.levels, self.steps)):
+            if ring.total:
+                last = ring.last()
+                if math.hypot(x - last[0], y - last[1]) < step:
+                    break  # coarser levels are further apart still
+            ring.append(x, y)
+            if level == 0:
+                self.version += 1
+                self._cover(x, y)
+
+    def _cell(self, v: float) -> int:
+        """Coverage grid index of a coordinate (m); negative below -extent."""
+        return math.floor((v + self.extent) / self.cell)
+
+    def _cover(self, x: float, y: float) -> None:
+        ci = self._cell(x)
+        cj = self._cell(y)
+        i = self.stencil[0] + ci
+        j = self.stencil[1] + cj
+        cells = len(self.covered)
+        inside = (i >= 0) & (i < cells) & (j >= 0) & (j < cells)
+        self.covered[i[inside], j[inside]] = True
+
+    def polyline(self, max_points: int = DRAW_MAX) -> np.ndarray:
+        """The trail as (N, 2) points, N <= max_points, from the finest level that fits."""
+        for ring in self.levels:
+            if len(ring) <= max_points:
+                return ring.ordered()
+        return self.levels[-1].ordered()[-max_points:]
+
+    def covered_area(self) -> float:
+        """m^2 swept by the sensors inside the coverage extent."""
+        return float(np.count_nonzero(self.covered)) * self.cell ** 2
+
+    def coverage(self, x0: float, y0: float, x1: float, y1: float) -> float:
+        """Fraction of the rectangle (x0, y0)-(x1, y1) swept by the sensors, both corners' cells included."""
+        i0, i1 = (self._cell(v) for v in sorted((x0, x1)))
+        j0, j1 = (self._cell(v) for v in sorted((y0, y1)))
+        cells = len(self.covered)
+        area = self.covered[max(i0, 0):min(i1 + 1, cells), max(j0, 0):min(j1 + 1, cells)]
+        return float(area.mean()) if area.size else 0.0
@@ -0,0 +1,189 @@
+// Builds WebSocket messages in place in a fixed buffer owned by the bridge.
+//
+// The buffer keeps WEBSOCKETS_MAX_HEADER_SIZE bytes free in front of the
+// payload. frame() hands the whole buffer to sendTXT/sendBIN with
+// headerToPayload = true. The WebSockets library then writes the frame header
+// into that space and sends header and payload with one write. It does not
+// malloc a buffer and copy the payload into it, as it does for a plain
+// payload. The payload is left intact, so one built message can go to
+// several clients.
+//
+// The JSON helpers insert commas and quotes themselves and format numbers
+// without printf. They cover what the bridge sends: objects, arrays, integers,
+// fixed-point floats and short strings. A message that does not fit sets
+// overflowed() and stops growing; it is still valid up to the last complete
+// append, but callers should not send it.
+
+#ifndef _FRAME_BUILDER_H_
+#define _FRAME_BUILDER_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef WEBSOCKETS_MAX_HEADER_SIZE
+#define WEBSOCKETS_MAX_HEADER_SIZE 14
+#endif
+
+#define FRAME_BUILDER_DEPTH_MAX 8
+
+template<size_t CAPACITY>
+class FrameBuilder {
+  public:
+    FrameBuilder() { reset(); }
+
+    void reset() {
+      used = 0;
+      depth = 0;
+      separate = 0;
+      overflow = false;
+    }
+
+    uint8_t *frame() { return buffer; }     // for send*(..., headerToPayload = true)
+    const uint8_t *payload() const { return buffer + WEBSOCKETS_MAX_HEADER_SIZE; }
+    size_t length() const { return used; }
+    bool overflowed() const { return overflow; }
+
+    // raw bytes; returns where they went, 0 if they did not fit
+    uint8_t *append(const void *data, size_t size) {
+      if (overflow || used + size > CAPACITY) {
+        overflow = true;
+        return 0;
+      }
+      uint8_t *at = buffer + WEBSOCKETS_MAX_HEADER_SIZE + used;
+      memcpy(at, data, size);
+      used += size;
+      return at;
+    }
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    void key(const char *name) {
+      element();
+      string(name, strlen(name));
+      put(':');
+      separate &= ~(1 << depth);  // the value that follows takes no comma
+    }
+
+    void value(long number) {
+      element();
+      integer(number);
+    }
+
+    void value(unsigned long number) {
+      element();
+      unsignedInteger(number);
+    }
+
+    void value(int number) { value((long)number); }
+    void value(unsigned int number) { value((unsigned long)number); }
+
+    // fixed point with the given number of decimals; NaN and infinity become null
+    void value(float number, uint8_t decimals) {
+      element();
+      if (isnan(number) || isinf(number)) {
+        append("null", 4);
+        return;
+      }
+      long scale = 1;
+      for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+      long scaled = lround(number * scale);
+      if (scaled < 0) {
+        put('-');
+        scaled = -scaled;
+      }
+      unsignedInteger(scaled / scale);
+      if (!decimals) return;
+      put('.');
+      char digits[10];
+      long fraction = scaled % scale;
+      for (uint8_t i = decimals; i > 0; i--) {
+        digits[i - 1] = '0' + fraction % 10;
+        fraction /= 10;
+      }
+      append(digits, decimals);
+    }
+
+    void value(const char *text) { value(text, strlen(text)); }
+
+    void value(const char *text, size_t length) {
+      element();
+      string(text, length);
+    }
+
+    template<class T> void field(const char *name, T number) {
+      key(name);
+      value(number);
+    }
+
+    void field(const char *name, float number, uint8_t decimals) {
+      key(name);
+      value(number, decimals);
+    }
+
+    void field(const char *name, const char *text, size_t length) {
+      key(name);
+      value(text, length);
+    }
+
+  private:
+    void put(char c) { append(&c, 1); }
+
+    // a comma before every element but the first of its container
+    void element() {
+      if (separate & (1 << depth)) put(',');
+      separate |= 1 << depth;
+    }
+
+    void open(char bracket) {
+      element();
+      put(bracket);
+      if (depth < FRAME_BUILDER_DEPTH_MAX - 1) depth++;
+      separate &= ~(1 << depth);
+    }
+
+    void close(char bracket) {
+      put(bracket);
+      if (depth) depth--;
+    }
+
+    void unsignedInteger(unsigned long number) {
+      char digits[10];
+      uint8_t count = 0;
+      do {
+        digits[sizeof(digits) - ++count] = '0' + number % 10;
+        number /= 10;
+      } while (number);
+      append(digits + sizeof(digits) - count, count);
+    }
+
+    void integer(long number) {
+      if (number < 0) {
+        put('-');
+        unsignedInteger(0UL - (unsigned long)number);
+      } else {
+        unsignedInteger(number);
+      }
+    }
+
+    void string(const char *text, size_t length) {
+      put('"');
+      for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') put('\\');
+        if ((uint8_t)c >= 0x20) put(c);
+      }
+      put('"');
+    }
+
+    uint8_t buffer[WEBSOCKETS_MAX_HEADER_SIZE + CAPACITY];
+    size_t used;
+    uint8_t depth;
+    uint8_t separate;       // bit per depth: the next element needs a comma
+    bool overflow;
+};
+
+#endif // _FRAME_BUILDER_H_
@@ -0,0 +1,59 @@
+// Cooperative scheduler for the Uno's main loop.
+//
+// A table of periodic tasks, run from loop(). Each task has a release: the
+// micros() at which it becomes ready. One runTasks() pass runs every task
+// whose release has come, in table order, so the order of the table is the
+// priority. A task that was kept from starting for a whole period or more
+// does not catch up: it runs once, and the releases it missed are counted
+// in skipped. The deadline is measured from the release, so a late start
+// counts towards an overrun as much as a long run does.
+
+#ifndef _TASK_SCHEDULER_H_
+#define _TASK_SCHEDULER_H_
+
+#include <Arduino.h>
+
+struct Task {
+  const char *name;         // up to 4 characters, for the report
+  void (*run)();
+  uint32_t period;          // us
+  uint32_t deadline;        // us from the release
+  unsigned long release;    // micros() of the next release
+  uint32_t runs;
+  uint32_t overruns;        // finished past the deadline
+  uint32_t skipped;         // releases missed entirely (not started within the period)
+  uint32_t wcet;            // us, longest run
+};
+
+// First release of every task: now
+inline void startTasks(Task *tasks, uint8_t count) {
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < count; i++) tasks[i].release = now;
+}
+
+// One scheduler pass
+inline void runTasks(Task *tasks, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    Task &task = tasks[i];
+    unsigned long start = micros();
+    if ((long)(start - task.release) < 0) continue;
+
+    unsigned long release = task.release;
+    uint32_t late = start - release;
+    if (late >= task.period) {
+      uint32_t missed = late / task.period;
+      task.skipped += missed;
+      release += missed * task.period;
+    }
+    task.release = release + task.period;
+
+    task.run();
+
+    unsigned long end = micros();
+    if (end - start > task.wcet) task.wcet = end - start;
+    if (end - release > task.deadline) task.overruns++;
+    task.runs++;
+  }
+}
+
+#endif
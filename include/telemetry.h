@@ -0,0 +1,120 @@
+// Binary telemetry frames sent by the ESP8266 bridge as WebSocket BIN messages.
+//
+// Layout is little-endian and packed; client/telemetry.py mirrors it as a
+// struct format and numpy dtypes. Every frame is 32 bytes: a common header
+// and a payload that depends on the stream. A BIN message carries one or
+// more frames back to back (the bridge batches when a client's link is slow). Bump
+// TELEMETRY_VERSION on any layout change.
+//
+// Clients get JSON text by default and switch to binary by sending
+//   {"format": "binary", "version": TELEMETRY_VERSION}
+// The bridge answers {"format": "binary"|"json", "version": N} with the format
+// it will actually use, so an older bridge or client falls back to JSON.
+//
+// Each client has its own send queue and stream rates, set at runtime with
+// {"stream": "pose", "hz": 200}; the bridge answers with the rate it applied
+// (0 turns a stream off). A full queue drops its oldest frames, so a slow
+// client loses samples rather than delaying the others. {"clients": 1}
+// returns every client's rates, queue depth and sent, dropped and blocked
+// counters as JSON.
+// {"tasks": 1} returns the Uno's scheduler statistics (runs, worst-case
+// execution time and deadline overruns per task) as JSON.
+//
+// The client drives the robot with 12-byte TelemetryCommand BIN messages
+// (linear and angular velocity setpoints). The bridge forwards them to the
+// Uno as they are. The JSON {"cmd": "forward"|...|"none"} commands still work
+// and map to fixed setpoints.
+//
+// A command carries an id and the client's own timestamp of the key press
+// behind it. Once the Uno reports the setpoint written to the motors, the
+// bridge sends that client a TELEMETRY_STREAM_TRACE frame echoing both, with
+// the time the setpoint spent on each hop from the bridge on. The client
+// measures the rest against its own clock (client/latency.py).
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <stdint.h>
+
+#define TELEMETRY_MAGIC     0xA5
+#define TELEMETRY_VERSION   3
+
+// streams
+#define TELEMETRY_STREAM_POSE       0
+#define TELEMETRY_STREAM_SENSORS    1
+#define TELEMETRY_STREAM_HEALTH     2
+#define TELEMETRY_STREAMS           3       // sampled streams; the ones below are sent on events
+#define TELEMETRY_STREAM_TRACE      3
+
+// flags
+#define TELEMETRY_FLAG_MINE     0x01    // mine detector triggered on this sample
+#define TELEMETRY_FLAG_MOVING   0x02    // pose, sensors: the last setpoint sent to the Uno is not a stop
+#define TELEMETRY_FLAG_STALE    0x04    // pose: no odometry from the Uno recently, values are the last known
+
+#define TELEMETRY_RANGES        3       // front, left, right
+#define TELEMETRY_RANGE_NONE    0       // no echo / sensor absent
+
+struct __attribute__((packed)) TelemetryPose {
+  float x;              // m
+  float y;              // m
+  float heading;        // rad, counter-clockwise from +x
+  uint8_t reserved[8];
+};
+
+struct __attribute__((packed)) TelemetrySensors {
+  uint16_t range[TELEMETRY_RANGES];  // mm
+  uint8_t reserved[14];
+};
+
+struct __attribute__((packed)) TelemetryHealth {
+  uint32_t freeHeap;        // bytes
+  uint32_t loopsPerSecond;
+  uint32_t dropped;         // this client's frames dropped under backpressure since it connected
+  uint16_t batch;           // this client's current frames per BIN message
+  uint8_t clients;
+  uint8_t reserved[5];
+};
+
+struct __attribute__((packed)) TelemetryTrace {
+  uint32_t origin;          // TelemetryCommand::origin, echoed
+  uint8_t id;               // TelemetryCommand::id, echoed
+  uint8_t reserved0;
+  uint16_t bridge;          // us, command received -> setpoint written to the UART
+  uint16_t uart;            // us, bridge -> Uno one way: half the UART round trip less the Uno's time
+  uint16_t uno;             // us, setpoint received on the Uno -> motor PWM written
+  uint8_t reserved[8];
+};
+
+struct __attribute__((packed)) TelemetryFrame {
+  uint8_t magic;        // TELEMETRY_MAGIC
+  uint8_t version;      // TELEMETRY_VERSION
+  uint8_t stream;       // TELEMETRY_STREAM_*
+  uint8_t flags;        // TELEMETRY_FLAG_*
+  uint32_t seq;         // per stream, wraps
+  uint32_t timestamp;   // micros() on the bridge, wraps every ~71 minutes
+  union {
+    TelemetryPose pose;
+    TelemetrySensors sensors;
+    TelemetryHealth health;
+    TelemetryTrace trace;
+  };
+};
+
+static_assert(sizeof(TelemetryFrame) == 32, "TelemetryFrame layout is shared with client/telemetry.py");
+
+#define TELEMETRY_COMMAND_MAGIC     0x5A
+#define TELEMETRY_COMMAND_SETPOINT  1
+
+struct __attribute__((packed)) TelemetryCommand {
+  uint8_t magic;        // TELEMETRY_COMMAND_MAGIC
+  uint8_t version;      // TELEMETRY_VERSION
+  uint8_t type;         // TELEMETRY_COMMAND_*
+  uint8_t id;           // echoed in the trace
+  int16_t linear;       // mm/s, forward positive
+  int16_t angular;      // mrad/s, counter-clockwise positive
+  uint32_t origin;      // client's clock at the key press, us; echoed in the trace
+};
+
+static_assert(sizeof(TelemetryCommand) == 12, "TelemetryCommand layout is shared with client/telemetry.py");
+
+#endif // _TELEMETRY_H_
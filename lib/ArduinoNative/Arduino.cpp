@@ -0,0 +1,384 @@
+// ArduinoNative - host-side Arduino core implementation
+
+#include "Arduino.h"
+
+#include <stdio.h>
+
+// Reading the clock is not free on the target either (micros() is ~4us on a
+// 16MHz AVR); charging for it also guarantees that busy-wait loops polling
+// millis()/micros() terminate.
+#define NATIVE_CLOCK_READ_COST_US   1
+
+// Hardware TX FIFO of the AVR core; writes beyond it block until drained
+#define NATIVE_SERIAL_TX_BUFFER     64
+
+// HC-SR04: the echo line rises about this long after the trigger pulse ends
+#define NATIVE_ECHO_DELAY_US        460
+#define NATIVE_EDGES_MAX            8
+
+static uint64_t nowMicros = 0;
+
+static uint8_t pinModes[NUM_DIGITAL_PINS];
+static uint8_t digitalOut[NUM_DIGITAL_PINS];
+static uint8_t digitalIn[NUM_DIGITAL_PINS];
+static int analogOut[NUM_DIGITAL_PINS];
+static int analogIn[NUM_DIGITAL_PINS];
+static uint32_t pulseWidth[NUM_DIGITAL_PINS];
+static void (*isr[NUM_DIGITAL_PINS])(void);
+static uint8_t echoPin[NUM_DIGITAL_PINS];     // by trigger pin, 0xFF = none
+static uint32_t echoWidth[NUM_DIGITAL_PINS];
+
+struct NativeEdge {
+    uint64_t at;
+    uint8_t pin;
+    uint8_t level;
+};
+static NativeEdge edges[NATIVE_EDGES_MAX];
+static uint8_t edgeCount = 0;
+static bool interruptsEnabled = true;
+static bool inInterrupt = false;
+
+uint32_t NativeBoard::pinWrites = 0;
+uint32_t NativeBoard::pulseInCalls = 0;
+uint64_t NativeBoard::pulseInBlockedMicros = 0;
+
+HardwareSerial Serial;
+
+// ---------------------------------------------------------------------------
+// time
+// ---------------------------------------------------------------------------
+
+unsigned long millis() {
+    nowMicros += NATIVE_CLOCK_READ_COST_US;
+    return (unsigned long)(nowMicros / 1000);
+}
+
+unsigned long micros() {
+    nowMicros += NATIVE_CLOCK_READ_COST_US;
+    return (unsigned long)nowMicros;
+}
+
+void delay(unsigned long ms) {
+    nowMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    nowMicros += us;
+}
+
+void yield() {
+}
+
+// ---------------------------------------------------------------------------
+// pins
+// ---------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= NUM_DIGITAL_PINS) return;
+    pinModes[pin] = mode;
+    if (mode == INPUT_PULLUP) digitalIn[pin] = HIGH;
+}
+
+static void scheduleEdge(uint64_t at, uint8_t pin, uint8_t level) {
+    if (edgeCount < NATIVE_EDGES_MAX) edges[edgeCount++] = { at, pin, level };
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin >= NUM_DIGITAL_PINS) return;
+    bool falling = digitalOut[pin] == HIGH && !val;
+    digitalOut[pin] = val ? HIGH : LOW;
+    NativeBoard::pinWrites++;
+    if (falling && echoPin[pin] != 0xFF && echoWidth[pin]) {
+        uint64_t rise = nowMicros + NATIVE_ECHO_DELAY_US;
+        scheduleEdge(rise, echoPin[pin], HIGH);
+        scheduleEdge(rise + echoWidth[pin], echoPin[pin], LOW);
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS) return LOW;
+    return digitalIn[pin];
+}
+
+void analogWrite(uint8_t pin, int val) {
+    if (pin >= NUM_DIGITAL_PINS) return;
+    analogOut[pin] = constrain(val, 0, 255);
+    NativeBoard::pinWrites++;
+}
+
+int analogRead(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS) return 0;
+    return analogIn[pin];
+}
+
+/** Wait for a scripted pulse on a pin.
+ * The call blocks (in virtual time) for as long as the real one would: the
+ * scripted pulse width when it fits in the timeout, the full timeout
+ * otherwise.
+ */
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout) {
+    (void)state;
+    NativeBoard::pulseInCalls++;
+    uint32_t width = pin < NUM_DIGITAL_PINS ? pulseWidth[pin] : 0;
+    if (width == 0 || width > timeout) {
+        nowMicros += timeout;
+        NativeBoard::pulseInBlockedMicros += timeout;
+        return 0;
+    }
+    nowMicros += width;
+    NativeBoard::pulseInBlockedMicros += width;
+    return width;
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+    (void)mode;
+    if (interruptNum < NUM_DIGITAL_PINS) isr[interruptNum] = userFunc;
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+    if (interruptNum < NUM_DIGITAL_PINS) isr[interruptNum] = 0;
+}
+
+void interrupts() {
+    interruptsEnabled = true;
+}
+
+void noInterrupts() {
+    interruptsEnabled = false;
+}
+
+// ---------------------------------------------------------------------------
+// math
+// ---------------------------------------------------------------------------
+
+static uint32_t randomState = 1;
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    // xorshift32, so runs are reproducible across libc implementations
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState % howbig;
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) randomState = seed;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ---------------------------------------------------------------------------
+// Print
+// ---------------------------------------------------------------------------
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::print(long n, int base) {
+    if (base == DEC && n < 0) {
+        size_t t = print('-');
+        return t + print((unsigned long)-n, base);
+    }
+    return print((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+    return write(str);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[48];
+    if (isnan(n)) return write("nan");
+    if (isinf(n)) return write("inf");
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+// ---------------------------------------------------------------------------
+// Serial
+// ---------------------------------------------------------------------------
+
+static uint64_t serialDrainedAt = 0;
+
+HardwareSerial::HardwareSerial() : baud(0), bytesWritten(0), bytesRead(0), rxHead(0), echo(false) {
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    this->baud = baud;
+}
+
+void HardwareSerial::end() {
+    baud = 0;
+}
+
+int HardwareSerial::available() {
+    return (int)(rx.size() - rxHead);
+}
+
+int HardwareSerial::read() {
+    if (rxHead >= rx.size()) return -1;
+    bytesRead++;
+    uint8_t c = rx[rxHead++];
+    if (rxHead == rx.size()) {
+        rx.clear();
+        rxHead = 0;
+    }
+    return c;
+}
+
+int HardwareSerial::peek() {
+    if (rxHead >= rx.size()) return -1;
+    return (uint8_t)rx[rxHead];
+}
+
+/** Free space in the TX FIFO, from the bytes still draining at the current baud rate. */
+int HardwareSerial::availableForWrite() {
+    if (!baud || serialDrainedAt <= nowMicros) return NATIVE_SERIAL_TX_BUFFER;
+    uint64_t byteMicros = 10000000ULL / baud;
+    uint64_t queued = (serialDrainedAt - nowMicros + byteMicros - 1) / byteMicros;
+    return queued >= NATIVE_SERIAL_TX_BUFFER ? 0 : (int)(NATIVE_SERIAL_TX_BUFFER - queued);
+}
+
+/** Queue one byte on the UART.
+ * Each byte occupies the line for 10 bit times; once the TX FIFO is full the
+ * caller blocks until a slot drains, exactly like the AVR core does.
+ */
+size_t HardwareSerial::write(uint8_t c) {
+    tx.push_back((char)c);
+    bytesWritten++;
+    if (echo) fputc(c, stdout);
+    if (baud) {
+        uint64_t byteMicros = 10000000ULL / baud;
+        if (serialDrainedAt < nowMicros) serialDrainedAt = nowMicros;
+        serialDrainedAt += byteMicros;
+        uint64_t queued = (serialDrainedAt - nowMicros) / byteMicros;
+        if (queued > NATIVE_SERIAL_TX_BUFFER) {
+            nowMicros = serialDrainedAt - NATIVE_SERIAL_TX_BUFFER * byteMicros;
+        }
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) write(buffer[i]);
+    return size;
+}
+
+void HardwareSerial::inject(const uint8_t *data, size_t length) {
+    rx.append((const char *)data, length);
+}
+
+void HardwareSerial::inject(const char *str) {
+    rx.append(str);
+}
+
+// ---------------------------------------------------------------------------
+// NativeBoard
+// ---------------------------------------------------------------------------
+
+void NativeBoard::reset() {
+    nowMicros = 0;
+    serialDrainedAt = 0;
+    memset(pinModes, 0, sizeof(pinModes));
+    memset(digitalOut, 0, sizeof(digitalOut));
+    memset(digitalIn, 0, sizeof(digitalIn));
+    memset(analogOut, 0, sizeof(analogOut));
+    memset(analogIn, 0, sizeof(analogIn));
+    memset(pulseWidth, 0, sizeof(pulseWidth));
+    memset(isr, 0, sizeof(isr));
+    memset(echoPin, 0xFF, sizeof(echoPin));
+    memset(echoWidth, 0, sizeof(echoWidth));
+    edgeCount = 0;
+    interruptsEnabled = true;
+    pinWrites = 0;
+    pulseInCalls = 0;
+    pulseInBlockedMicros = 0;
+}
+
+void NativeBoard::advanceMicros(uint32_t us) {
+    nowMicros += us;
+}
+
+uint64_t NativeBoard::elapsedMicros() {
+    return nowMicros;
+}
+
+uint8_t NativeBoard::getPinMode(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? pinModes[pin] : INPUT;
+}
+
+uint8_t NativeBoard::getDigitalOutput(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? digitalOut[pin] : LOW;
+}
+
+int NativeBoard::getAnalogOutput(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? analogOut[pin] : 0;
+}
+
+void NativeBoard::setDigitalInput(uint8_t pin, uint8_t level) {
+    if (pin < NUM_DIGITAL_PINS) digitalIn[pin] = level ? HIGH : LOW;
+}
+
+void NativeBoard::setAnalogInput(uint8_t pin, int value) {
+    if (pin < NUM_DIGITAL_PINS) analogIn[pin] = value;
+}
+
+void NativeBoard::setPulseWidth(uint8_t pin, uint32_t us) {
+    if (pin < NUM_DIGITAL_PINS) pulseWidth[pin] = us;
+}
+
+void NativeBoard::setEcho(uint8_t trigPin, uint8_t echo, uint32_t us) {
+    if (trigPin >= NUM_DIGITAL_PINS || echo >= NUM_DIGITAL_PINS) return;
+    echoPin[trigPin] = echo;
+    echoWidth[trigPin] = us;
+}
+
+/** Apply due edges in time order. The clock is wound back to each edge while
+ * its ISR runs, so micros() in the ISR reads the edge time as it would on
+ * the board, however late the harness gets round to it.
+ */
+void NativeBoard::update() {
+    while (edgeCount) {
+        uint8_t first = 0;
+        for (uint8_t i = 1; i < edgeCount; i++) {
+            if (edges[i].at < edges[first].at) first = i;
+        }
+        NativeEdge edge = edges[first];
+        if (edge.at > nowMicros) return;
+        edges[first] = edges[--edgeCount];
+
+        digitalIn[edge.pin] = edge.level;
+        uint64_t now = nowMicros;
+        nowMicros = edge.at;
+        raiseInterrupt(edge.pin);
+        nowMicros = now;
+    }
+}
+
+void NativeBoard::raiseInterrupt(uint8_t pin) {
+    if (pin >= NUM_DIGITAL_PINS || !isr[pin] || !interruptsEnabled || inInterrupt) return;
+    // ISRs run with interrupts masked, as on the AVR
+    inInterrupt = true;
+    isr[pin]();
+    inInterrupt = false;
+}
@@ -0,0 +1,133 @@
+// ArduinoNative - host-side Arduino core for the `native` PlatformIO environment
+//
+// Provides just enough of the Arduino API (time, digital/analog pins,
+// pulseIn, interrupts, Serial, PROGMEM helpers) for src/arduino.cpp,
+// src/esp.cpp, I2Cdev and MPU6050 to compile and run on a Linux host.
+//
+// Time is virtual: it only moves when the firmware waits (delay*, pulseIn),
+// talks on the I2C bus (see Wire.h) or reads the clock, so runs are
+// deterministic and bus costs show up as elapsed micros().
+
+#ifndef _ARDUINO_NATIVE_H_
+#define _ARDUINO_NATIVE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <type_traits>
+
+#include "pgmspace.h"
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define PI          3.1415926535897932384626433832795
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+#define NUM_DIGITAL_PINS    20
+
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+#define NOT_AN_INTERRUPT    -1
+#define digitalPinToInterrupt(p) ((p) < NUM_DIGITAL_PINS ? (p) : NOT_AN_INTERRUPT)
+
+template<class T, class U> inline typename std::common_type<T, U>::type min(T a, U b) { return a < b ? a : b; }
+template<class T, class U> inline typename std::common_type<T, U>::type max(T a, U b) { return a > b ? a : b; }
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+int analogRead(uint8_t pin);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout = 1000000L);
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void interrupts();
+void noInterrupts();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+void yield();
+
+/** Simulation control for the native board.
+ * The firmware never calls these; the harness (NativeMain.cpp) and bench
+ * scenarios use them to script inputs and read back what the sketch did.
+ */
+class NativeBoard {
+    public:
+        static void reset();
+
+        // virtual clock
+        static void advanceMicros(uint32_t us);
+        static uint64_t elapsedMicros();
+
+        // pin state as driven by the sketch
+        static uint8_t getPinMode(uint8_t pin);
+        static uint8_t getDigitalOutput(uint8_t pin);
+        static int getAnalogOutput(uint8_t pin);
+
+        // pin state as seen by the sketch
+        static void setDigitalInput(uint8_t pin, uint8_t level);
+        static void setAnalogInput(uint8_t pin, int value);
+        static void setPulseWidth(uint8_t pin, uint32_t us);
+
+        // HC-SR04 style sensor: each HIGH->LOW on trigPin is answered by a
+        // pulse of the given width on echoPin (0 = no echo)
+        static void setEcho(uint8_t trigPin, uint8_t echoPin, uint32_t us);
+
+        // deliver scripted input edges that are due, running their ISRs at
+        // the edge's time
+        static void update();
+
+        // fire the ISR attached to a pin (no-op when none is attached or
+        // interrupts are disabled)
+        static void raiseInterrupt(uint8_t pin);
+
+        static uint32_t pinWrites;
+        static uint32_t pulseInCalls;
+        static uint64_t pulseInBlockedMicros;
+};
+
+#endif /* _ARDUINO_NATIVE_H_ */
@@ -0,0 +1,6 @@
+// ArduinoNative - ESP8266 core singletons
+
+#include "ESP8266WiFi.h"
+
+ESP8266WiFiClass WiFi;
+EspClass ESP;
@@ -0,0 +1,29 @@
+// ArduinoNative - soft-AP subset of ESP8266WiFi used by the bridge firmware
+
+#ifndef _ARDUINO_NATIVE_ESP8266WIFI_H_
+#define _ARDUINO_NATIVE_ESP8266WIFI_H_
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class ESP8266WiFiClass {
+    public:
+        bool softAP(const char *ssid, const char *passphrase = 0) {
+            (void)ssid;
+            (void)passphrase;
+            return true;
+        }
+        IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+};
+
+class EspClass {
+    public:
+        // the host has no heap budget to report; mirror a freshly booted NodeMCU
+        uint32_t getFreeHeap() { return 40000; }
+        uint32_t getCycleCount() { return (uint32_t)(NativeBoard::elapsedMicros() * 80); }
+};
+
+extern ESP8266WiFiClass WiFi;
+extern EspClass ESP;
+
+#endif /* _ARDUINO_NATIVE_ESP8266WIFI_H_ */
@@ -0,0 +1,58 @@
+// ArduinoNative - Serial port backed by in-memory buffers
+// Bytes the sketch writes are captured (and optionally echoed to stdout);
+// bytes the harness injects are what Serial.read() returns.
+
+#ifndef _ARDUINO_NATIVE_HARDWARESERIAL_H_
+#define _ARDUINO_NATIVE_HARDWARESERIAL_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "Print.h"
+
+class Stream : public Print {
+    public:
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+    public:
+        HardwareSerial();
+
+        void begin(unsigned long baud);
+        void end();
+        operator bool() { return true; }
+
+        int available() override;
+        int read() override;
+        int peek() override;
+        int availableForWrite();
+        void flush() {}
+
+        using Print::write;
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        // harness side
+        void inject(const uint8_t *data, size_t length);
+        void inject(const char *str);
+        const std::string &output() const { return tx; }
+        void clearOutput() { tx.clear(); }
+        void setEcho(bool enabled) { echo = enabled; }
+
+        unsigned long baud;
+        uint32_t bytesWritten;
+        uint32_t bytesRead;
+
+    private:
+        std::string rx;
+        size_t rxHead;
+        std::string tx;
+        bool echo;
+};
+
+extern HardwareSerial Serial;
+
+#endif /* _ARDUINO_NATIVE_HARDWARESERIAL_H_ */
@@ -0,0 +1,33 @@
+// ArduinoNative - IPv4 address as printed by the ESP8266 core
+
+#ifndef _ARDUINO_NATIVE_IPADDRESS_H_
+#define _ARDUINO_NATIVE_IPADDRESS_H_
+
+#include <stdint.h>
+
+#include "Print.h"
+
+class IPAddress : public Printable {
+    public:
+        IPAddress() { octets[0] = octets[1] = octets[2] = octets[3] = 0; }
+        IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+            octets[0] = a; octets[1] = b; octets[2] = c; octets[3] = d;
+        }
+
+        uint8_t operator[](int index) const { return octets[index & 3]; }
+        uint8_t &operator[](int index) { return octets[index & 3]; }
+
+        size_t printTo(Print &p) const override {
+            size_t n = 0;
+            for (int i = 0; i < 4; i++) {
+                if (i) n += p.print('.');
+                n += p.print((unsigned int)octets[i]);
+            }
+            return n;
+        }
+
+    private:
+        uint8_t octets[4];
+};
+
+#endif /* _ARDUINO_NATIVE_IPADDRESS_H_ */
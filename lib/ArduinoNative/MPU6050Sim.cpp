@@ -0,0 +1,292 @@
+// ArduinoNative - in-memory MPU6050 I2C slave implementation
+
+#include "MPU6050Sim.h"
+
+// register addresses (see MPU6050.h; duplicated so the simulator does not
+// depend on the driver it is exercising)
+#define SIM_RA_XA_OFFS_H        0x06
+#define SIM_RA_XG_OFFS_USRH     0x13
+#define SIM_RA_GYRO_CONFIG      0x1B
+#define SIM_RA_ACCEL_CONFIG     0x1C
+#define SIM_RA_INT_ENABLE       0x38
+#define SIM_RA_INT_STATUS       0x3A
+#define SIM_RA_ACCEL_XOUT_H     0x3B
+#define SIM_RA_GYRO_ZOUT_L      0x48
+#define SIM_RA_USER_CTRL        0x6A
+#define SIM_RA_PWR_MGMT_1       0x6B
+#define SIM_RA_BANK_SEL         0x6D
+#define SIM_RA_MEM_START_ADDR   0x6E
+#define SIM_RA_MEM_R_W          0x6F
+#define SIM_RA_FIFO_COUNTH      0x72
+#define SIM_RA_FIFO_COUNTL      0x73
+#define SIM_RA_FIFO_R_W         0x74
+#define SIM_RA_WHO_AM_I         0x75
+
+#define SIM_USERCTRL_DMP_EN         0x80
+#define SIM_USERCTRL_FIFO_EN        0x40
+#define SIM_USERCTRL_DMP_RESET      0x08
+#define SIM_USERCTRL_FIFO_RESET     0x04
+#define SIM_USERCTRL_I2C_MST_RESET  0x02
+#define SIM_USERCTRL_SIG_COND_RESET 0x01
+#define SIM_PWR1_DEVICE_RESET       0x80
+
+#define SIM_INT_FIFO_OFLOW          0x10
+#define SIM_INT_DMP                 0x02
+
+// the DMP firmware keeps its FIFO rate divisor here (bank 2, offset 0x16)
+#define SIM_DMP_RATE_DIVISOR_ADDR   (2 * 256 + 0x16)
+
+MPU6050Sim::MPU6050Sim(uint8_t address) : address(address), intPin(255), packetSize(42) {
+    setAccel(0, 0, 16384);
+    setAccelBias(0, 0, 0);
+    setGyro(0, 0, 0);
+    setGyroBias(0, 0, 0);
+    setQuaternion(1, 0, 0, 0);
+    yawRate = 0;
+    powerOnReset();
+    packetsQueued = 0;
+    fifoOverflowBytes = 0;
+    fifoBytesRead = 0;
+    fifoResets = 0;
+    memoryBytesWritten = 0;
+    memoryBytesRead = 0;
+    interruptsRaised = 0;
+}
+
+void MPU6050Sim::begin(TwoWire &bus, uint8_t intPin) {
+    this->intPin = intPin;
+    bus.attach(address, this);
+    lastPacketAt = NativeBoard::elapsedMicros();
+}
+
+void MPU6050Sim::powerOnReset() {
+    memset(regs, 0, sizeof(regs));
+    memset(mem, 0, sizeof(mem));
+    regs[SIM_RA_PWR_MGMT_1] = 0x40; // SLEEP
+    regs[SIM_RA_WHO_AM_I] = 0x68;
+    regPointer = 0;
+    fifoHead = fifoLength = 0;
+    fifoCountLow = 0;
+    lastPacketAt = NativeBoard::elapsedMicros();
+}
+
+void MPU6050Sim::setAccel(int16_t x, int16_t y, int16_t z) {
+    accel[0] = x; accel[1] = y; accel[2] = z;
+}
+
+void MPU6050Sim::setAccelBias(int16_t x, int16_t y, int16_t z) {
+    accelBias[0] = x; accelBias[1] = y; accelBias[2] = z;
+}
+
+void MPU6050Sim::setGyro(int16_t x, int16_t y, int16_t z) {
+    gyro[0] = x; gyro[1] = y; gyro[2] = z;
+}
+
+void MPU6050Sim::setGyroBias(int16_t x, int16_t y, int16_t z) {
+    gyroBias[0] = x; gyroBias[1] = y; gyroBias[2] = z;
+}
+
+void MPU6050Sim::setQuaternion(float w, float x, float y, float z) {
+    quat[0] = w; quat[1] = x; quat[2] = y; quat[3] = z;
+}
+
+void MPU6050Sim::setYawRate(float radiansPerSecond) {
+    yawRate = radiansPerSecond;
+}
+
+void MPU6050Sim::setPacketSize(uint8_t size) {
+    packetSize = size > MPU6050_SIM_MAX_PACKET ? MPU6050_SIM_MAX_PACKET : size;
+}
+
+/** DMP output period in microseconds: 200Hz / (1 + divisor). */
+uint32_t MPU6050Sim::packetPeriod() const {
+    uint16_t divisor = ((uint16_t)mem[SIM_DMP_RATE_DIVISOR_ADDR] << 8) | mem[SIM_DMP_RATE_DIVISOR_ADDR + 1];
+    return (uint32_t)MPU6050_SIM_BASE_RATE_US * (1 + divisor);
+}
+
+void MPU6050Sim::update() {
+    uint64_t now = NativeBoard::elapsedMicros();
+    uint8_t ctrl = regs[SIM_RA_USER_CTRL];
+    if (!(ctrl & SIM_USERCTRL_DMP_EN) || !(ctrl & SIM_USERCTRL_FIFO_EN)) {
+        lastPacketAt = now;
+        return;
+    }
+    uint32_t period = packetPeriod();
+    while (now - lastPacketAt >= period) {
+        lastPacketAt += period;
+        if (yawRate != 0) {
+            // rotate about world Z by yawRate * period: q = dq * q
+            float half = yawRate * period * 0.0000005f;
+            float c = cosf(half), s = sinf(half);
+            float w = c * quat[0] - s * quat[3];
+            float x = c * quat[1] - s * quat[2];
+            float y = c * quat[2] + s * quat[1];
+            float z = c * quat[3] + s * quat[0];
+            setQuaternion(w, x, y, z);
+        }
+        pushPacket();
+    }
+}
+
+/** Queue one DMP packet in the MotionApps 2.0 layout.
+ * [QUAT W,X,Y,Z: int32 Q30][GYRO X,Y,Z: int32][ACCEL X,Y,Z: int32][pad]
+ * Gyro/accel carry the raw sample in the high word; accel is scaled to the
+ * DMP's +1g = 8192.
+ */
+void MPU6050Sim::pushPacket() {
+    uint8_t packet[MPU6050_SIM_MAX_PACKET];
+    int32_t words[10];
+    memset(packet, 0, sizeof(packet));
+    for (uint8_t i = 0; i < 4; i++) words[i] = (int32_t)(quat[i] * 1073741824.0f);
+    for (uint8_t i = 0; i < 3; i++) words[4 + i] = (int32_t)gyro[i] << 16;
+    for (uint8_t i = 0; i < 3; i++) words[7 + i] = (int32_t)(accel[i] >> 1) << 16;
+    for (uint8_t i = 0; i < 10 && (i + 1) * 4 <= packetSize; i++) {
+        packet[i * 4] = (uint8_t)(words[i] >> 24);
+        packet[i * 4 + 1] = (uint8_t)(words[i] >> 16);
+        packet[i * 4 + 2] = (uint8_t)(words[i] >> 8);
+        packet[i * 4 + 3] = (uint8_t)words[i];
+    }
+    pushFIFO(packet, packetSize);
+    packetsQueued++;
+    raiseDataInterrupt();
+}
+
+void MPU6050Sim::pushFIFO(const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (fifoLength == MPU6050_SIM_FIFO_SIZE) {
+            // full: the oldest byte is lost, as on the real part
+            fifoHead = (fifoHead + 1) % MPU6050_SIM_FIFO_SIZE;
+            fifoLength--;
+            fifoOverflowBytes++;
+            regs[SIM_RA_INT_STATUS] |= SIM_INT_FIFO_OFLOW;
+        }
+        fifo[(fifoHead + fifoLength) % MPU6050_SIM_FIFO_SIZE] = data[i];
+        fifoLength++;
+    }
+}
+
+void MPU6050Sim::raiseDataInterrupt() {
+    if (!(regs[SIM_RA_INT_ENABLE] & SIM_INT_DMP)) return;
+    regs[SIM_RA_INT_STATUS] |= SIM_INT_DMP;
+    interruptsRaised++;
+    if (intPin != 255) NativeBoard::raiseInterrupt(intPin);
+}
+
+void MPU6050Sim::i2cWrite(const uint8_t *data, uint8_t length) {
+    update();
+    if (length == 0) return;
+    regPointer = data[0] & 0x7F;
+    for (uint8_t i = 1; i < length; i++) {
+        writeRegister(regPointer, data[i]);
+        // FIFO and DMP memory ports do not advance the register pointer
+        if (regPointer != SIM_RA_FIFO_R_W && regPointer != SIM_RA_MEM_R_W) regPointer = (regPointer + 1) & 0x7F;
+    }
+}
+
+uint8_t MPU6050Sim::i2cRead() {
+    update();
+    uint8_t value = readRegister(regPointer);
+    if (regPointer != SIM_RA_FIFO_R_W && regPointer != SIM_RA_MEM_R_W) regPointer = (regPointer + 1) & 0x7F;
+    return value;
+}
+
+void MPU6050Sim::writeRegister(uint8_t reg, uint8_t value) {
+    switch (reg) {
+        case SIM_RA_PWR_MGMT_1:
+            if (value & SIM_PWR1_DEVICE_RESET) {
+                uint8_t pin = intPin;
+                powerOnReset();
+                intPin = pin;
+                return;
+            }
+            break;
+        case SIM_RA_USER_CTRL:
+            if (value & SIM_USERCTRL_FIFO_RESET) {
+                fifoHead = fifoLength = 0;
+                fifoResets++;
+            }
+            if (value & SIM_USERCTRL_DMP_RESET) lastPacketAt = NativeBoard::elapsedMicros();
+            // reset bits self-clear
+            value &= ~(SIM_USERCTRL_DMP_RESET | SIM_USERCTRL_FIFO_RESET | SIM_USERCTRL_I2C_MST_RESET | SIM_USERCTRL_SIG_COND_RESET);
+            if ((value & SIM_USERCTRL_DMP_EN) && !(regs[reg] & SIM_USERCTRL_DMP_EN)) lastPacketAt = NativeBoard::elapsedMicros();
+            break;
+        case SIM_RA_MEM_R_W: {
+            uint16_t at = (uint16_t)(regs[SIM_RA_BANK_SEL] & 0x07) * 256 + regs[SIM_RA_MEM_START_ADDR];
+            mem[at] = value;
+            memoryBytesWritten++;
+            regs[SIM_RA_MEM_START_ADDR]++;
+            return;
+        }
+        case SIM_RA_FIFO_R_W:
+            pushFIFO(&value, 1);
+            return;
+        case SIM_RA_INT_STATUS:
+        case SIM_RA_FIFO_COUNTH:
+        case SIM_RA_FIFO_COUNTL:
+        case SIM_RA_WHO_AM_I:
+            return; // read-only
+    }
+    regs[reg] = value;
+}
+
+uint8_t MPU6050Sim::readRegister(uint8_t reg) {
+    if (reg >= SIM_RA_ACCEL_XOUT_H && reg <= SIM_RA_GYRO_ZOUT_L) {
+        // words start at the odd ACCEL_XOUT_H address, high byte first
+        uint8_t low = (reg - SIM_RA_ACCEL_XOUT_H) & 1;
+        int16_t w = sensorWord(reg - low);
+        return low ? (uint8_t)w : (uint8_t)(w >> 8);
+    }
+    switch (reg) {
+        case SIM_RA_INT_STATUS: {
+            uint8_t status = regs[reg];
+            regs[reg] = 0; // cleared on read
+            return status;
+        }
+        case SIM_RA_FIFO_COUNTH:
+            // reading the high byte latches the low byte
+            fifoCountLow = (uint8_t)fifoLength;
+            return (uint8_t)(fifoLength >> 8);
+        case SIM_RA_FIFO_COUNTL:
+            return fifoCountLow;
+        case SIM_RA_FIFO_R_W: {
+            if (fifoLength == 0) return 0;
+            uint8_t b = fifo[fifoHead];
+            fifoHead = (fifoHead + 1) % MPU6050_SIM_FIFO_SIZE;
+            fifoLength--;
+            fifoBytesRead++;
+            return b;
+        }
+        case SIM_RA_MEM_R_W: {
+            uint16_t at = (uint16_t)(regs[SIM_RA_BANK_SEL] & 0x07) * 256 + regs[SIM_RA_MEM_START_ADDR];
+            memoryBytesRead++;
+            regs[SIM_RA_MEM_START_ADDR]++;
+            return mem[at];
+        }
+    }
+    return regs[reg];
+}
+
+/** Sensor output for the word starting at [reg].
+ * The user offset registers shift the output the way the silicon does:
+ * one accel offset LSB is 8 LSB at +/-2g, one gyro offset LSB is 4 LSB at
+ * +/-250dps; both then scale with the selected full-scale range.
+ */
+int16_t MPU6050Sim::sensorWord(uint8_t reg) {
+    uint8_t afs = (regs[SIM_RA_ACCEL_CONFIG] >> 3) & 0x03;
+    uint8_t gfs = (regs[SIM_RA_GYRO_CONFIG] >> 3) & 0x03;
+    int32_t v;
+    if (reg < 0x41) {
+        uint8_t axis = (reg - SIM_RA_ACCEL_XOUT_H) / 2;
+        int16_t offset = ((int16_t)regs[SIM_RA_XA_OFFS_H + axis * 2] << 8) | regs[SIM_RA_XA_OFFS_H + axis * 2 + 1];
+        v = ((int32_t)accel[axis] + accelBias[axis] + (int32_t)offset * 8) >> afs;
+    } else if (reg == 0x41) {
+        v = 0; // TEMP_OUT: 36.53 degC
+    } else {
+        uint8_t axis = (reg - 0x43) / 2;
+        int16_t offset = ((int16_t)regs[SIM_RA_XG_OFFS_USRH + axis * 2] << 8) | regs[SIM_RA_XG_OFFS_USRH + axis * 2 + 1];
+        v = ((int32_t)gyro[axis] + gyroBias[axis] + (int32_t)offset * 4) >> gfs;
+    }
+    if (v > 32767) v = 32767;
+    if (v < -32768) v = -32768;
+    return (int16_t)v;
+}
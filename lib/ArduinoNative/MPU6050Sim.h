@@ -0,0 +1,96 @@
+// ArduinoNative - in-memory MPU6050 I2C slave
+//
+// Models the parts of the register map the firmware touches: the register
+// file with auto-increment, device/FIFO/DMP resets, accel/gyro outputs that
+// respond to the offset registers (so the calibration PID converges), the
+// DMP memory banks behind BANK_SEL/MEM_START_ADDR/MEM_R_W, and a 1024-byte
+// FIFO that the "DMP" fills with packets at the firmware-selected rate and
+// signals on the INT pin.
+
+#ifndef _MPU6050_SIM_H_
+#define _MPU6050_SIM_H_
+
+#include <stdint.h>
+
+#include "Wire.h"
+
+#define MPU6050_SIM_FIFO_SIZE       1024
+#define MPU6050_SIM_MEMORY_SIZE     (8 * 256)
+#define MPU6050_SIM_MAX_PACKET      64
+#define MPU6050_SIM_BASE_RATE_US    5000    // DMP output at divisor 0 (200 Hz)
+
+class MPU6050Sim : public I2CSlave {
+    public:
+        MPU6050Sim(uint8_t address = 0x68);
+
+        // attach to a bus and optionally wire INT to an Arduino pin (255 = not wired)
+        void begin(TwoWire &bus = Wire, uint8_t intPin = 255);
+        void powerOnReset();
+
+        // advance the DMP to the current virtual time, queueing due packets
+        void update();
+
+        // scripted motion, in +/-2g and +/-250dps LSB units before offsets
+        void setAccel(int16_t x, int16_t y, int16_t z);
+        void setAccelBias(int16_t x, int16_t y, int16_t z);
+        void setGyro(int16_t x, int16_t y, int16_t z);
+        void setGyroBias(int16_t x, int16_t y, int16_t z);
+
+        // orientation reported by the DMP, and a constant yaw rate applied per packet
+        void setQuaternion(float w, float x, float y, float z);
+        void setYawRate(float radiansPerSecond);
+
+        // DMP packet shape (42 bytes for MotionApps 2.0)
+        void setPacketSize(uint8_t size);
+
+        // direct FIFO scripting
+        void pushFIFO(const uint8_t *data, uint16_t length);
+        void pushPacket();
+        uint16_t fifoCount() const { return fifoLength; }
+
+        uint8_t getRegister(uint8_t reg) const { return regs[reg & 0x7F]; }
+        void setRegister(uint8_t reg, uint8_t value) { regs[reg & 0x7F] = value; }
+        const uint8_t *memory() const { return mem; }
+
+        // I2CSlave
+        void i2cWrite(const uint8_t *data, uint8_t length) override;
+        uint8_t i2cRead() override;
+
+        uint32_t packetsQueued;
+        uint32_t fifoOverflowBytes;
+        uint32_t fifoBytesRead;
+        uint32_t fifoResets;
+        uint32_t memoryBytesWritten;
+        uint32_t memoryBytesRead;
+        uint32_t interruptsRaised;
+
+    private:
+        void writeRegister(uint8_t reg, uint8_t value);
+        uint8_t readRegister(uint8_t reg);
+        int16_t sensorWord(uint8_t reg);
+        void raiseDataInterrupt();
+        uint32_t packetPeriod() const;
+
+        uint8_t address;
+        uint8_t intPin;
+        uint8_t regPointer;
+        uint8_t regs[128];
+        uint8_t mem[MPU6050_SIM_MEMORY_SIZE];
+
+        uint8_t fifo[MPU6050_SIM_FIFO_SIZE];
+        uint16_t fifoHead;
+        uint16_t fifoLength;
+        uint8_t fifoCountLow;
+
+        int16_t accel[3], accelBias[3];
+        int16_t gyro[3], gyroBias[3];
+        float quat[4];
+        float yawRate;
+        uint8_t packetSize;
+        uint64_t lastPacketAt;
+};
+
+// the instance attached at 0x68 by the native harness (NativeMain.cpp)
+extern MPU6050Sim NativeMPU;
+
+#endif /* _MPU6050_SIM_H_ */
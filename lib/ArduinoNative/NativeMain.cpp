@@ -0,0 +1,141 @@
+// ArduinoNative - entry point for the `native` environments
+//
+// Runs the sketch's setup() once and loop() a fixed number of times on the
+// virtual board, then reports loop latency (host and virtual time), I2C
+// bus traffic, Serial/WebSocket output and MPU6050 FIFO activity.
+//
+//   .pio/build/native/program [--loops N] [--loop-us US] [--serial STR]
+//                             [--ws-client N] [--ws-text STR] [--ws-rate BPS] [--echo]
+//
+// A sketch-side scenario can script inputs per iteration by defining
+//   void nativeScenario(uint32_t iteration);
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "MPU6050Sim.h"
+#include "WebSocketsServer.h"
+
+#define NATIVE_MPU_INT_PIN  2
+
+MPU6050Sim NativeMPU;
+
+void setup();
+void loop();
+
+__attribute__((weak)) void nativeScenario(uint32_t iteration) {
+    (void)iteration;
+}
+
+static uint64_t percentile(std::vector<uint64_t> &samples, double p) {
+    if (samples.empty()) return 0;
+    size_t index = (size_t)(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+int main(int argc, char **argv) {
+    uint32_t loops = 10000;
+    uint32_t loopMicros = 0;
+    const char *serialInput = 0;
+    const char *wsText = 0;
+    int wsClient = -1;
+    uint32_t wsRate = 0;
+    bool echo = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--loops") && i + 1 < argc) loops = strtoul(argv[++i], 0, 10);
+        else if (!strcmp(argv[i], "--loop-us") && i + 1 < argc) loopMicros = strtoul(argv[++i], 0, 10);
+        else if (!strcmp(argv[i], "--serial") && i + 1 < argc) serialInput = argv[++i];
+        else if (!strcmp(argv[i], "--ws-client") && i + 1 < argc) wsClient = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ws-text") && i + 1 < argc) wsText = argv[++i];
+        else if (!strcmp(argv[i], "--ws-rate") && i + 1 < argc) wsRate = strtoul(argv[++i], 0, 10);
+        else if (!strcmp(argv[i], "--echo")) echo = true;
+        else {
+            fprintf(stderr, "usage: %s [--loops N] [--loop-us US] [--serial STR] [--ws-client N] [--ws-text STR] [--ws-rate BPS] [--echo]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    NativeBoard::reset();
+    Serial.setEcho(echo);
+    NativeMPU.begin(Wire, NATIVE_MPU_INT_PIN);
+
+    uint64_t setupStart = NativeBoard::elapsedMicros();
+    setup();
+    uint64_t setupMicros = NativeBoard::elapsedMicros() - setupStart;
+    uint32_t setupTransactions = Wire.transactions;
+    Wire.resetCounters();
+    uint32_t setupSerialBytes = Serial.bytesWritten;
+    Serial.bytesWritten = 0;
+
+    if (serialInput) Serial.inject(serialInput);
+    WebSocketsServer *ws = WebSocketsServer::instance;
+    if (ws) ws->setLinkRate(wsRate);
+    if (ws && wsClient >= 0) {
+        ws->simulateConnect(wsClient);
+        if (wsText) ws->simulateText(wsClient, wsText);
+    }
+
+    std::vector<uint64_t> hostNanos, virtualMicros;
+    hostNanos.reserve(loops);
+    virtualMicros.reserve(loops);
+    for (uint32_t i = 0; i < loops; i++) {
+        nativeScenario(i);
+        NativeBoard::update();
+        NativeMPU.update();
+        uint64_t v0 = NativeBoard::elapsedMicros();
+        auto t0 = std::chrono::steady_clock::now();
+        loop();
+        auto t1 = std::chrono::steady_clock::now();
+        virtualMicros.push_back(NativeBoard::elapsedMicros() - v0);
+        hostNanos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        NativeBoard::advanceMicros(loopMicros);
+        if (!echo && Serial.output().size() > 65536) Serial.clearOutput();
+    }
+    if (echo) fflush(stdout);
+
+    uint64_t hostTotal = 0, virtualTotal = 0;
+    for (uint64_t n : hostNanos) hostTotal += n;
+    for (uint64_t n : virtualMicros) virtualTotal += n;
+    double perLoop = loops ? 1.0 / loops : 0;
+
+    printf("\n== native run: %u loop() iterations ==\n", loops);
+    printf("setup():          %llu us virtual, %u I2C transactions, %u Serial bytes\n",
+           (unsigned long long)setupMicros, setupTransactions, setupSerialBytes);
+    printf("loop() host:      mean %.0f ns, p50 %llu ns, p99 %llu ns, max %llu ns\n",
+           hostTotal * perLoop,
+           (unsigned long long)percentile(hostNanos, 0.50),
+           (unsigned long long)percentile(hostNanos, 0.99),
+           (unsigned long long)percentile(hostNanos, 1.0));
+    printf("loop() virtual:   mean %.1f us, p50 %llu us, p99 %llu us, max %llu us\n",
+           virtualTotal * perLoop,
+           (unsigned long long)percentile(virtualMicros, 0.50),
+           (unsigned long long)percentile(virtualMicros, 0.99),
+           (unsigned long long)percentile(virtualMicros, 1.0));
+    printf("I2C:              %u transactions (%u write, %u read), %u/%u bytes out/in, %llu us on the bus, %u NACKs\n",
+           Wire.transactions, Wire.writeTransactions, Wire.readTransactions,
+           Wire.bytesWritten, Wire.bytesRead, (unsigned long long)Wire.busMicros, Wire.nacks);
+    printf("Serial:           %u bytes out, %u bytes in\n", Serial.bytesWritten, Serial.bytesRead);
+    printf("pins:             %u writes, %u pulseIn() calls blocking %llu us\n",
+           NativeBoard::pinWrites, NativeBoard::pulseInCalls, (unsigned long long)NativeBoard::pulseInBlockedMicros);
+    printf("MPU6050 FIFO:     %u packets queued, %u bytes drained, %u overflow bytes, %u resets, %u interrupts\n",
+           NativeMPU.packetsQueued, NativeMPU.fifoBytesRead, NativeMPU.fifoOverflowBytes,
+           NativeMPU.fifoResets, NativeMPU.interruptsRaised);
+    if (ws) {
+        uint32_t frames = 0, bytes = 0;
+        for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+            frames += ws->framesSent[i];
+            bytes += ws->bytesSent[i];
+        }
+        printf("WebSocket:        %u frames, %u bytes sent, %u payload copies, %u events delivered, %llu us blocked on send\n",
+               frames, bytes, ws->payloadCopies, ws->eventsDelivered, (unsigned long long)ws->sendBlockedMicros);
+    }
+    return 0;
+}
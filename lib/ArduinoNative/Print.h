@@ -0,0 +1,53 @@
+// ArduinoNative - Print/Printable subset of the Arduino core
+
+#ifndef _ARDUINO_NATIVE_PRINT_H_
+#define _ARDUINO_NATIVE_PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class Print;
+
+class Printable {
+    public:
+        virtual ~Printable() {}
+        virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+    public:
+        virtual ~Print() {}
+
+        virtual size_t write(uint8_t c) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size);
+        size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+        size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+        size_t print(const __FlashStringHelper *s) { return write((const char *)s); }
+        size_t print(const String &s) { return write(s.c_str(), s.length()); }
+        size_t print(const char s[]) { return write(s); }
+        size_t print(char c) { return write((uint8_t)c); }
+        size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+        size_t print(int n, int base = DEC) { return print((long)n, base); }
+        size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+        size_t print(long n, int base = DEC);
+        size_t print(unsigned long n, int base = DEC);
+        size_t print(double n, int digits = 2);
+        size_t print(const Printable &x) { return x.printTo(*this); }
+
+        size_t println() { return write("\r\n"); }
+        template<typename T> size_t println(const T &x) { size_t n = print(x); return n + println(); }
+        template<typename T> size_t println(const T &x, int format) { size_t n = print(x, format); return n + println(); }
+};
+
+#endif /* _ARDUINO_NATIVE_PRINT_H_ */
@@ -0,0 +1,52 @@
+// ArduinoNative - Arduino String on top of std::string
+// Heap behaviour differs from the ESP8266 core, but the API used by the
+// bridge firmware (and ArduinoJson's String adapter) is the same.
+
+#ifndef _ARDUINO_NATIVE_WSTRING_H_
+#define _ARDUINO_NATIVE_WSTRING_H_
+
+#include <string.h>
+#include <string>
+
+class String {
+    public:
+        String(const char *cstr = "") : buf(cstr ? cstr : "") {}
+        String(const char *cstr, unsigned int length) : buf(cstr, length) {}
+        String(const String &str) = default;
+        String(char c) : buf(1, c) {}
+        explicit String(int value) : buf(std::to_string(value)) {}
+        explicit String(unsigned int value) : buf(std::to_string(value)) {}
+        explicit String(long value) : buf(std::to_string(value)) {}
+        explicit String(unsigned long value) : buf(std::to_string(value)) {}
+
+        String &operator=(const String &rhs) = default;
+        String &operator=(const char *cstr) { buf = cstr ? cstr : ""; return *this; }
+
+        unsigned int length() const { return buf.size(); }
+        const char *c_str() const { return buf.c_str(); }
+        bool reserve(unsigned int size) { buf.reserve(size); return true; }
+        char operator[](unsigned int index) const { return index < buf.size() ? buf[index] : 0; }
+
+        bool concat(const String &str) { buf += str.buf; return true; }
+        bool concat(const char *cstr) { if (cstr) buf += cstr; return true; }
+        bool concat(const char *cstr, unsigned int length) { buf.append(cstr, length); return true; }
+        bool concat(char c) { buf += c; return true; }
+        String &operator+=(const String &rhs) { concat(rhs); return *this; }
+        String &operator+=(const char *cstr) { concat(cstr); return *this; }
+        String &operator+=(char c) { concat(c); return *this; }
+
+        bool equals(const char *cstr) const { return buf == (cstr ? cstr : ""); }
+        bool operator==(const String &rhs) const { return buf == rhs.buf; }
+        bool operator==(const char *cstr) const { return equals(cstr); }
+        bool operator!=(const String &rhs) const { return buf != rhs.buf; }
+        bool operator!=(const char *cstr) const { return !equals(cstr); }
+
+        friend String operator+(const String &lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+        friend String operator+(const String &lhs, const char *rhs) { String s(lhs); s += rhs; return s; }
+        friend String operator+(const char *lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+
+    private:
+        std::string buf;
+};
+
+#endif /* _ARDUINO_NATIVE_WSTRING_H_ */
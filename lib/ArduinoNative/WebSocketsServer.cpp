@@ -0,0 +1,150 @@
+// ArduinoNative - in-memory WebSocket server implementation
+
+#include "WebSocketsServer.h"
+
+WebSocketsServer *WebSocketsServer::instance = 0;
+
+WebSocketsServer::WebSocketsServer(uint16_t port) {
+    (void)port;
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        connected[i] = false;
+        lastBinary[i] = false;
+        linkRate[i] = 0;
+        linkBuffer[i] = WEBSOCKETS_NATIVE_SNDBUF;
+        linkQueued[i] = 0;
+        linkDrainedAt[i] = 0;
+    }
+    resetCounters();
+    instance = this;
+}
+
+void WebSocketsServer::begin() {
+}
+
+void WebSocketsServer::loop() {
+    while (!pending.empty()) {
+        Pending p = pending.front();
+        pending.pop_front();
+        if (p.type == WStype_CONNECTED) connected[p.num] = true;
+        if (p.type == WStype_DISCONNECTED) connected[p.num] = false;
+        eventsDelivered++;
+        if (event) event(p.num, p.type, (uint8_t *)&p.payload[0], p.payload.size());
+    }
+}
+
+bool WebSocketsServer::deliver(uint8_t num, const uint8_t *payload, size_t length, bool binary, bool headerToPayload) {
+    if (!clientIsConnected(num)) return false;
+    if (!headerToPayload && length > 0 && length < WEBSOCKETS_NATIVE_COPY_MAX) payloadCopies++;
+    chargeLink(num, length + (length < 126 ? 2 : 4)); // payload + server frame header
+    framesSent[num]++;
+    bytesSent[num] += length;
+    last[num].assign((const char *)payload, length);
+    lastBinary[num] = binary;
+    return true;
+}
+
+bool WebSocketsServer::broadcast(const uint8_t *payload, size_t length, bool binary, bool headerToPayload) {
+    bool ok = true;
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        if (connected[i]) ok &= deliver(i, payload, length, binary, headerToPayload);
+    }
+    return ok;
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, const uint8_t *payload, size_t length) {
+    return deliver(num, payload, length, false);
+}
+
+bool WebSocketsServer::broadcastTXT(const uint8_t *payload, size_t length) {
+    return broadcast(payload, length, false, false);
+}
+
+bool WebSocketsServer::sendBIN(uint8_t num, const uint8_t *payload, size_t length) {
+    return deliver(num, payload, length, true);
+}
+
+bool WebSocketsServer::broadcastBIN(const uint8_t *payload, size_t length) {
+    return broadcast(payload, length, true, false);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, uint8_t *payload, size_t length, bool headerToPayload) {
+    return deliver(num, payload + (headerToPayload ? WEBSOCKETS_MAX_HEADER_SIZE : 0), length, false, headerToPayload);
+}
+
+bool WebSocketsServer::broadcastTXT(uint8_t *payload, size_t length, bool headerToPayload) {
+    return broadcast(payload + (headerToPayload ? WEBSOCKETS_MAX_HEADER_SIZE : 0), length, false, headerToPayload);
+}
+
+bool WebSocketsServer::sendBIN(uint8_t num, uint8_t *payload, size_t length, bool headerToPayload) {
+    return deliver(num, payload + (headerToPayload ? WEBSOCKETS_MAX_HEADER_SIZE : 0), length, true, headerToPayload);
+}
+
+bool WebSocketsServer::broadcastBIN(uint8_t *payload, size_t length, bool headerToPayload) {
+    return broadcast(payload + (headerToPayload ? WEBSOCKETS_MAX_HEADER_SIZE : 0), length, true, headerToPayload);
+}
+
+int WebSocketsServer::connectedClients(bool ping) {
+    (void)ping;
+    int n = 0;
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) n += connected[i];
+    return n;
+}
+
+void WebSocketsServer::simulateConnect(uint8_t num) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) pending.push_back({num, WStype_CONNECTED, std::string()});
+}
+
+void WebSocketsServer::simulateDisconnect(uint8_t num) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) pending.push_back({num, WStype_DISCONNECTED, std::string()});
+}
+
+void WebSocketsServer::simulateText(uint8_t num, const char *payload) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) pending.push_back({num, WStype_TEXT, std::string(payload)});
+}
+
+void WebSocketsServer::simulateBinary(uint8_t num, const uint8_t *payload, size_t length) {
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX) pending.push_back({num, WStype_BIN, std::string((const char *)payload, length)});
+}
+
+void WebSocketsServer::setLinkRate(uint32_t bytesPerSecond, uint16_t sendBuffer) {
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) setClientLinkRate(i, bytesPerSecond, sendBuffer);
+}
+
+void WebSocketsServer::setClientLinkRate(uint8_t num, uint32_t bytesPerSecond, uint16_t sendBuffer) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX) return;
+    linkRate[num] = bytesPerSecond;
+    linkBuffer[num] = sendBuffer;
+    linkQueued[num] = 0;
+    linkDrainedAt[num] = NativeBoard::elapsedMicros();
+}
+
+/** Queue bytes on a client's modelled link, blocking until they fit its send buffer. */
+void WebSocketsServer::chargeLink(uint8_t num, size_t bytes) {
+    if (!linkRate[num]) return;
+    uint64_t now = NativeBoard::elapsedMicros();
+    double &queued = linkQueued[num];
+    queued -= (now - linkDrainedAt[num]) * (double)linkRate[num] / 1000000.0;
+    if (queued < 0) queued = 0;
+    linkDrainedAt[num] = now;
+    double excess = queued + bytes - linkBuffer[num];
+    if (excess > 0) {
+        uint32_t us = (uint32_t)(excess * 1000000.0 / linkRate[num] + 0.5);
+        NativeBoard::advanceMicros(us);
+        sendBlockedMicros += us;
+        clientBlockedMicros[num] += us;
+        queued -= us * (double)linkRate[num] / 1000000.0;
+        linkDrainedAt[num] = NativeBoard::elapsedMicros();
+    }
+    queued += bytes;
+}
+
+void WebSocketsServer::resetCounters() {
+    for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        framesSent[i] = 0;
+        bytesSent[i] = 0;
+        clientBlockedMicros[i] = 0;
+    }
+    eventsDelivered = 0;
+    payloadCopies = 0;
+    sendBlockedMicros = 0;
+}
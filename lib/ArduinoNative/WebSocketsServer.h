@@ -0,0 +1,123 @@
+// ArduinoNative - in-memory stand-in for links2004/WebSockets' server
+//
+// Same public surface the bridge firmware uses. Frames the sketch sends are
+// counted per client and the last one is kept for inspection; the harness
+// scripts client connects and messages, which are delivered from loop()
+// just like the real server does.
+//
+// A send of a plain payload shorter than 1400 bytes is counted in
+// payloadCopies: the real library mallocs a buffer for header and payload and
+// copies the payload into it. A payload sent with headerToPayload = true has
+// the header space reserved in front of it and goes out without the copy.
+//
+// By default sends are free. setLinkRate() puts a TCP send buffer in front of
+// a link of fixed throughput, for every client; setClientLinkRate() for one.
+// A send that does not fit the buffer then blocks and charges virtual time,
+// like a synchronous WiFiClient write on the ESP8266.
+
+#ifndef _ARDUINO_NATIVE_WEBSOCKETSSERVER_H_
+#define _ARDUINO_NATIVE_WEBSOCKETSSERVER_H_
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <deque>
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+#define WEBSOCKETS_NATIVE_SNDBUF     2920    // lwIP TCP_SND_BUF on the ESP8266 (2 x MSS)
+#define WEBSOCKETS_MAX_HEADER_SIZE   14
+#define WEBSOCKETS_NATIVE_COPY_MAX   1400    // below this the library copies header and payload into one buffer
+
+typedef enum {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_FRAGMENT_TEXT_START,
+    WStype_FRAGMENT_BIN_START,
+    WStype_FRAGMENT,
+    WStype_FRAGMENT_FIN,
+    WStype_PING,
+    WStype_PONG,
+} WStype_t;
+
+class WebSocketsServer {
+    public:
+        typedef std::function<void(uint8_t num, WStype_t type, uint8_t *payload, size_t length)> WebSocketServerEvent;
+
+        WebSocketsServer(uint16_t port);
+
+        void begin();
+        void loop();
+        void onEvent(WebSocketServerEvent cbEvent) { event = cbEvent; }
+
+        bool sendTXT(uint8_t num, const uint8_t *payload, size_t length);
+        bool sendTXT(uint8_t num, const char *payload) { return sendTXT(num, (const uint8_t *)payload, strlen(payload)); }
+        bool sendTXT(uint8_t num, const String &payload) { return sendTXT(num, (const uint8_t *)payload.c_str(), payload.length()); }
+        bool broadcastTXT(const uint8_t *payload, size_t length);
+        bool broadcastTXT(const char *payload) { return broadcastTXT((const uint8_t *)payload, strlen(payload)); }
+        bool broadcastTXT(const String &payload) { return broadcastTXT((const uint8_t *)payload.c_str(), payload.length()); }
+
+        bool sendBIN(uint8_t num, const uint8_t *payload, size_t length);
+        bool broadcastBIN(const uint8_t *payload, size_t length);
+
+        // payload starts WEBSOCKETS_MAX_HEADER_SIZE bytes in when headerToPayload is set
+        bool sendTXT(uint8_t num, uint8_t *payload, size_t length, bool headerToPayload);
+        bool broadcastTXT(uint8_t *payload, size_t length, bool headerToPayload);
+        bool sendBIN(uint8_t num, uint8_t *payload, size_t length, bool headerToPayload);
+        bool broadcastBIN(uint8_t *payload, size_t length, bool headerToPayload);
+
+        IPAddress remoteIP(uint8_t num) { return IPAddress(192, 168, 4, 2 + num); }
+        bool clientIsConnected(uint8_t num) { return num < WEBSOCKETS_SERVER_CLIENT_MAX && connected[num]; }
+        int connectedClients(bool ping = false);
+
+        // harness side: scripted client activity, delivered on the next loop()
+        void simulateConnect(uint8_t num);
+        void simulateDisconnect(uint8_t num);
+        void simulateText(uint8_t num, const char *payload);
+        void simulateBinary(uint8_t num, const uint8_t *payload, size_t length);
+        void setLinkRate(uint32_t bytesPerSecond, uint16_t sendBuffer = WEBSOCKETS_NATIVE_SNDBUF);
+        void setClientLinkRate(uint8_t num, uint32_t bytesPerSecond, uint16_t sendBuffer = WEBSOCKETS_NATIVE_SNDBUF);
+
+        const std::string &lastFrame(uint8_t num) const { return last[num]; }
+        bool lastFrameBinary(uint8_t num) const { return lastBinary[num]; }
+        void resetCounters();
+
+        uint32_t framesSent[WEBSOCKETS_SERVER_CLIENT_MAX];
+        uint32_t bytesSent[WEBSOCKETS_SERVER_CLIENT_MAX];
+        uint32_t eventsDelivered;
+        uint32_t payloadCopies;
+        uint64_t sendBlockedMicros;
+        uint64_t clientBlockedMicros[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+        static WebSocketsServer *instance;
+
+    private:
+        struct Pending {
+            uint8_t num;
+            WStype_t type;
+            std::string payload;
+        };
+
+        bool deliver(uint8_t num, const uint8_t *payload, size_t length, bool binary, bool headerToPayload = false);
+        bool broadcast(const uint8_t *payload, size_t length, bool binary, bool headerToPayload);
+        void chargeLink(uint8_t num, size_t bytes);
+
+        WebSocketServerEvent event;
+        std::deque<Pending> pending;
+        bool connected[WEBSOCKETS_SERVER_CLIENT_MAX];
+        std::string last[WEBSOCKETS_SERVER_CLIENT_MAX];
+        bool lastBinary[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+        // per client: each has its own TCP connection
+        uint32_t linkRate[WEBSOCKETS_SERVER_CLIENT_MAX];
+        uint16_t linkBuffer[WEBSOCKETS_SERVER_CLIENT_MAX];
+        double linkQueued[WEBSOCKETS_SERVER_CLIENT_MAX];
+        uint64_t linkDrainedAt[WEBSOCKETS_SERVER_CLIENT_MAX];
+};
+
+#endif /* _ARDUINO_NATIVE_WEBSOCKETSSERVER_H_ */
@@ -0,0 +1,137 @@
+// ArduinoNative - Wire (TWI master) implementation
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire() : clock(100000), txAddress(0), txLength(0), transmitting(false), rxIndex(0), rxLength(0) {
+    for (uint8_t i = 0; i < WIRE_MAX_SLAVES; i++) slaves[i] = 0;
+    resetCounters();
+}
+
+void TwoWire::begin() {
+    rxIndex = rxLength = 0;
+    txLength = 0;
+}
+
+void TwoWire::end() {
+}
+
+void TwoWire::setClock(uint32_t clock) {
+    if (clock) this->clock = clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    transmitting = true;
+    txAddress = address;
+    txLength = 0;
+}
+
+/** Send the queued bytes to the addressed slave.
+ * @return 0 on success, 2 when no slave acknowledges the address (as AVR Wire)
+ */
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    transmitting = false;
+    transactions++;
+    writeTransactions++;
+    chargeBus(txLength + 1);
+    I2CSlave *slave = find(txAddress);
+    if (!slave) {
+        nacks++;
+        return 2;
+    }
+    bytesWritten += txLength;
+    slave->i2cWrite(txBuffer, txLength);
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+    (void)sendStop;
+    if (quantity > BUFFER_LENGTH) quantity = BUFFER_LENGTH;
+    transactions++;
+    readTransactions++;
+    rxIndex = 0;
+    rxLength = 0;
+    I2CSlave *slave = find(address);
+    if (!slave) {
+        nacks++;
+        chargeBus(1);
+        return 0;
+    }
+    for (uint8_t i = 0; i < quantity; i++) rxBuffer[i] = slave->i2cRead();
+    rxLength = quantity;
+    bytesRead += quantity;
+    chargeBus(quantity + 1);
+    return quantity;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!transmitting || txLength >= BUFFER_LENGTH) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+    size_t n = 0;
+    for (; n < quantity; n++) {
+        if (!write(data[n])) break;
+    }
+    return n;
+}
+
+int TwoWire::available() {
+    return rxLength - rxIndex;
+}
+
+int TwoWire::read() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex++];
+}
+
+int TwoWire::peek() {
+    if (rxIndex >= rxLength) return -1;
+    return rxBuffer[rxIndex];
+}
+
+void TwoWire::attach(uint8_t address, I2CSlave *slave) {
+    detach(address);
+    for (uint8_t i = 0; i < WIRE_MAX_SLAVES; i++) {
+        if (!slaves[i]) {
+            slaveAddress[i] = address;
+            slaves[i] = slave;
+            return;
+        }
+    }
+}
+
+void TwoWire::detach(uint8_t address) {
+    for (uint8_t i = 0; i < WIRE_MAX_SLAVES; i++) {
+        if (slaves[i] && slaveAddress[i] == address) slaves[i] = 0;
+    }
+}
+
+void TwoWire::resetCounters() {
+    transactions = 0;
+    writeTransactions = 0;
+    readTransactions = 0;
+    bytesWritten = 0;
+    bytesRead = 0;
+    nacks = 0;
+    busMicros = 0;
+}
+
+/** Charge START + [bytes] x 9 bit times (8 data + ACK) + STOP to the clock. */
+void TwoWire::chargeBus(uint16_t bytes) {
+    uint32_t bits = 2 + bytes * 9;
+    uint32_t us = (bits * 1000000UL + clock - 1) / clock;
+    busMicros += us;
+    NativeBoard::advanceMicros(us);
+}
+
+I2CSlave *TwoWire::find(uint8_t address) {
+    for (uint8_t i = 0; i < WIRE_MAX_SLAVES; i++) {
+        if (slaves[i] && slaveAddress[i] == address) return slaves[i];
+    }
+    return 0;
+}
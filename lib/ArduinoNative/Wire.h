@@ -0,0 +1,88 @@
+// ArduinoNative - Wire (TWI master) routed to in-memory I2C slaves
+//
+// Mirrors the Arduino AVR Wire semantics that I2Cdev depends on: a 32-byte
+// transmit/receive buffer, the first written byte selects the register,
+// requestFrom() returns what the slave clocks out. Every transaction is
+// counted and charged to the virtual clock at the configured bus speed.
+
+#ifndef _ARDUINO_NATIVE_WIRE_H_
+#define _ARDUINO_NATIVE_WIRE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+
+#define WIRE_MAX_SLAVES 4
+
+/** An I2C slave that can be attached to the simulated bus. */
+class I2CSlave {
+    public:
+        virtual ~I2CSlave() {}
+
+        // master wrote [data] after addressing us (START, addr+W, data..., STOP)
+        virtual void i2cWrite(const uint8_t *data, uint8_t length) = 0;
+
+        // master clocks one byte out of us (addr+R phase)
+        virtual uint8_t i2cRead() = 0;
+};
+
+class TwoWire : public Stream {
+    public:
+        TwoWire();
+
+        void begin();
+        void end();
+        void setClock(uint32_t clock);
+
+        void beginTransmission(uint8_t address);
+        void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+        uint8_t endTransmission(bool sendStop = true);
+
+        uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = true);
+        uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+        uint8_t requestFrom(int address, int quantity, int sendStop) { return requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)sendStop); }
+
+        using Print::write;
+        size_t write(uint8_t data) override;
+        size_t write(const uint8_t *data, size_t quantity) override;
+        int available() override;
+        int read() override;
+        int peek() override;
+
+        // simulation side
+        void attach(uint8_t address, I2CSlave *slave);
+        void detach(uint8_t address);
+        void resetCounters();
+
+        uint32_t clock;
+        uint32_t transactions;      // addressed START..STOP sequences
+        uint32_t writeTransactions;
+        uint32_t readTransactions;
+        uint32_t bytesWritten;      // payload bytes, excluding address bytes
+        uint32_t bytesRead;
+        uint32_t nacks;
+        uint64_t busMicros;         // virtual time spent clocking the bus
+
+    private:
+        void chargeBus(uint16_t bytes);
+        I2CSlave *find(uint8_t address);
+
+        uint8_t slaveAddress[WIRE_MAX_SLAVES];
+        I2CSlave *slaves[WIRE_MAX_SLAVES];
+
+        uint8_t txAddress;
+        uint8_t txBuffer[BUFFER_LENGTH];
+        uint8_t txLength;
+        bool transmitting;
+
+        uint8_t rxBuffer[BUFFER_LENGTH];
+        uint8_t rxIndex;
+        uint8_t rxLength;
+};
+
+extern TwoWire Wire;
+
+#endif /* _ARDUINO_NATIVE_WIRE_H_ */
@@ -3,6 +3,7 @@
 // 2013-06-05 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-17 - I2CDEV_TRANSPORT: reads and writes through an I2CdevTransport object
 //      2021-09-28 - allow custom Wire object as transaction function argument
 //      2020-01-20 - hardija : complete support for Teensy 3.x
 //      2015-10-30 - simondlevy : support i2c_t3 for Teensy3.1
@@ -296,6 +297,22 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
             count = -1; // error
         }
 
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT)
+
+        // I2Cdev transport object
+        // one combined transaction (register address, repeated START, data) per
+        // I2CDEVLIB_WIRE_BUFFER_LENGTH bytes, each from regAddr as with Wire above
+        I2CdevTransport *transport = I2CdevTransport::resolve(wireObj);
+        for (uint16_t k = 0; k < length; ) {
+            uint16_t chunk = length - k < I2CDEVLIB_WIRE_BUFFER_LENGTH ? length - k : I2CDEVLIB_WIRE_BUFFER_LENGTH;
+            if (!transport || !transport->read(devAddr, regAddr, data + k, chunk)) {
+                count = -1; // error
+                break;
+            }
+            k += chunk;
+            count = k;
+        }
+
     #endif
 
     // check for timeout
@@ -442,6 +459,26 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
             count = -1; // error
         }
 
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT)
+
+        // I2Cdev transport object
+        // words arrive MSB first into data's own bytes, then are put in host order
+        I2CdevTransport *transport = I2CdevTransport::resolve(wireObj);
+        uint8_t *bytes = (uint8_t *)data;
+        uint16_t total = (uint16_t)length * 2;
+        uint16_t k = 0;
+        while (k < total) {
+            uint16_t chunk = total - k < (I2CDEVLIB_WIRE_BUFFER_LENGTH & ~1) ? total - k : (I2CDEVLIB_WIRE_BUFFER_LENGTH & ~1);
+            if (!transport || !transport->read(devAddr, regAddr, bytes + k, chunk)) break;
+            k += chunk;
+        }
+        if (k == total) {
+            for (uint8_t i = 0; i < length; i++) data[i] = (bytes[2*i] << 8) | bytes[2*i + 1];
+            count = length; // success
+        } else {
+            count = -1; // error
+        }
+
     #endif
 
     if (timeout > 0 && millis() - t1 >= timeout && count < length) count = -1; // timeout
@@ -621,6 +658,10 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
     #elif (I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE)
         Fastwire::stop();
         //status = Fastwire::endTransmission();
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT)
+        // register address and data in one transaction
+        I2CdevTransport *transport = I2CdevTransport::resolve(wireObj);
+        status = transport && transport->write(devAddr, regAddr, data, length) ? 0 : 4;
     #endif
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
@@ -692,6 +733,18 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
     #elif (I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE)
         Fastwire::stop();
         //status = Fastwire::endTransmission();
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT)
+        // register address and the words, MSB first, in one transaction
+        I2CdevTransport *transport = I2CdevTransport::resolve(wireObj);
+        uint8_t bytes[I2CDEVLIB_WIRE_BUFFER_LENGTH];
+        status = 4;
+        if (transport && (uint16_t)length * 2 < I2CDEVLIB_WIRE_BUFFER_LENGTH) {
+            for (uint8_t i = 0; i < length; i++) {
+                bytes[2*i] = data[i] >> 8;
+                bytes[2*i + 1] = data[i];
+            }
+            if (transport->write(devAddr, regAddr, bytes, length * 2)) status = 0;
+        }
     #endif
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
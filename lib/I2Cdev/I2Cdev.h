@@ -3,6 +3,7 @@
 // 2013-06-05 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-17 - add I2CDEV_TRANSPORT: I2CdevTransport objects (Linux i2c-dev, in-process fake) as the bus
 //      2021-09-28 - allow custom Wire object as transaction function argument
 //      2020-01-20 - hardija : complete support for Teensy 3.x
 //      2015-10-30 - simondlevy : support i2c_t3 for Teensy3.1
@@ -62,6 +63,7 @@ THE SOFTWARE.
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_TEENSY_3X_WIRE
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_BUILTIN_SBWIRE
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_BUILTIN_FASTWIRE
+//#define I2CDEV_IMPLEMENTATION       I2CDEV_TRANSPORT
 #endif // I2CDEV_IMPLEMENTATION
 
 // comment this out if you are using a non-optimal IDE/implementation setting
@@ -78,6 +80,8 @@ THE SOFTWARE.
 #define I2CDEV_I2CMASTER_LIBRARY    4 // I2C object from DSSCircuits I2C-Master Library at https://github.com/DSSCircuits/I2C-Master-Library
 #define I2CDEV_BUILTIN_SBWIRE	    5 // I2C object from Shuning (Steve) Bian's SBWire Library at https://github.com/freespace/SBWire 
 #define I2CDEV_TEENSY_3X_WIRE       6 // Teensy 3.x support using i2c_t3 library
+#define I2CDEV_TRANSPORT            7 // I2CdevTransport object: Linux /dev/i2c-N (I2CdevLinux), in-process fake (I2CdevFake)
+                                      // or your own; builds without an Arduino core too (I2CdevHost.h)
 
 // -----------------------------------------------------------------------------
 // Arduino-style "Serial.print" debug constant (uncomment to enable)
@@ -104,6 +108,18 @@ THE SOFTWARE.
     #endif
 #endif
 
+#if I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT
+    #ifndef ARDUINO
+        #include "I2CdevHost.h"
+    #endif
+    #include "I2CdevTransport.h"
+    #ifndef I2CDEVLIB_WIRE_BUFFER_LENGTH
+        // no Wire buffer to fit; a read of three MotionApps 2.0 FIFO packets
+        // per transaction, and short enough for the stack buffers it sizes
+        #define I2CDEVLIB_WIRE_BUFFER_LENGTH 128
+    #endif
+#endif
+
 #ifdef SPARK
     #include "application.h"
     #define ARDUINO 101
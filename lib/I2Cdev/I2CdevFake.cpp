@@ -0,0 +1,107 @@
+// I2Cdev library collection - in-process fake I2C bus for I2CdevTransport
+// Routes transactions to device models in the same process and charges
+// each one the time it would take on a real bus
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "I2Cdev.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT
+
+#include "I2CdevFake.h"
+
+I2CdevFake::I2CdevFake(uint32_t clock) : busMicros(0), clock(clock ? clock : 400000) {
+    for (uint8_t i = 0; i < I2CDEV_FAKE_MAX_DEVICES; i++) devices[i] = 0;
+}
+
+/** Put a device model on the bus, replacing any already at that address. */
+void I2CdevFake::attach(uint8_t address, I2CdevFakeDevice *device) {
+    detach(address);
+    for (uint8_t i = 0; i < I2CDEV_FAKE_MAX_DEVICES; i++) {
+        if (!devices[i]) {
+            addresses[i] = address;
+            devices[i] = device;
+            return;
+        }
+    }
+}
+
+void I2CdevFake::detach(uint8_t address) {
+    for (uint8_t i = 0; i < I2CDEV_FAKE_MAX_DEVICES; i++) {
+        if (devices[i] && addresses[i] == address) devices[i] = 0;
+    }
+}
+
+void I2CdevFake::setClock(uint32_t clock) {
+    if (clock) this->clock = clock;
+}
+
+bool I2CdevFake::transferRead(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length) {
+    I2CdevFakeDevice *device = find(devAddr);
+    if (!device) {
+        charge(1, 2);
+        return false;
+    }
+    device->i2cWrite(&regAddr, 1);
+    for (uint16_t i = 0; i < length; i++) data[i] = device->i2cRead();
+    // START, addr+W, reg, repeated START, addr+R, data, STOP
+    charge(3 + length, 3);
+    return true;
+}
+
+bool I2CdevFake::transferWrite(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length) {
+    I2CdevFakeDevice *device = find(devAddr);
+    if (!device || length > I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) {
+        charge(1, 2);
+        return false;
+    }
+    uint8_t buffer[I2CDEVLIB_WIRE_BUFFER_LENGTH];
+    buffer[0] = regAddr;
+    for (uint16_t i = 0; i < length; i++) buffer[1 + i] = data[i];
+    device->i2cWrite(buffer, length + 1);
+    // START, addr+W, reg, data, STOP
+    charge(2 + length, 2);
+    return true;
+}
+
+I2CdevFakeDevice *I2CdevFake::find(uint8_t address) {
+    for (uint8_t i = 0; i < I2CDEV_FAKE_MAX_DEVICES; i++) {
+        if (devices[i] && addresses[i] == address) return devices[i];
+    }
+    return 0;
+}
+
+/** Charge [bytes] x 9 bit times (8 data + ACK) plus one per START/STOP condition. */
+void I2CdevFake::charge(uint16_t bytes, uint8_t conditions) {
+    uint32_t bits = conditions + bytes * 9UL;
+    uint32_t us = (bits * 1000000UL + clock - 1) / clock;
+    busMicros += us;
+    elapse(us);
+}
+
+#endif /* I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT */
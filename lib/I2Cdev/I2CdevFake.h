@@ -0,0 +1,85 @@
+// I2Cdev library collection - in-process fake I2C bus for I2CdevTransport
+// Routes transactions to device models in the same process and charges
+// each one the time it would take on a real bus
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _I2CDEV_FAKE_H_
+#define _I2CDEV_FAKE_H_
+
+#include "I2CdevTransport.h"
+
+#define I2CDEV_FAKE_MAX_DEVICES     4
+
+/** A device model behind I2CdevFake, seen the way a slave sees the bus. */
+class I2CdevFakeDevice {
+    public:
+        virtual ~I2CdevFakeDevice() {}
+
+        // master wrote [data] after addressing us: the register address first, then any payload
+        virtual void i2cWrite(const uint8_t *data, uint8_t length) = 0;
+
+        // master clocks one byte out of us
+        virtual uint8_t i2cRead() = 0;
+};
+
+/** I2CdevTransport that talks to I2CdevFakeDevice models instead of hardware.
+ * A read is handed to the device as a 1-byte write (the register address)
+ * followed by length i2cRead() calls, a write as one i2cWrite() of the
+ * address and payload, so models written for a plain Wire bus work as they
+ * are. Transactions to an address with no device fail, like a NACK. Every
+ * transaction is charged START/STOP plus 9 bit times per byte at the
+ * configured clock into busMicros and passed to elapse().
+ */
+class I2CdevFake : public I2CdevTransport {
+    public:
+        I2CdevFake(uint32_t clock=400000);
+
+        void attach(uint8_t address, I2CdevFakeDevice *device);
+        void detach(uint8_t address);
+        void setClock(uint32_t clock);
+
+        uint32_t busMicros;         // simulated bus time of all transactions
+
+    protected:
+        bool transferRead(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length);
+        bool transferWrite(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length);
+
+        // bus time of the transaction just done; override to advance a simulated clock
+        virtual void elapse(uint32_t us) { (void)us; }
+
+    private:
+        I2CdevFakeDevice *find(uint8_t address);
+        void charge(uint16_t bytes, uint8_t conditions);
+
+        uint32_t clock;
+        uint8_t addresses[I2CDEV_FAKE_MAX_DEVICES];
+        I2CdevFakeDevice *devices[I2CDEV_FAKE_MAX_DEVICES];
+};
+
+#endif /* _I2CDEV_FAKE_H_ */
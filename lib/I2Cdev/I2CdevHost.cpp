@@ -0,0 +1,93 @@
+// I2Cdev library collection - the few Arduino core calls device classes use, for hosts without one
+// Lets I2Cdev with I2CDEV_TRANSPORT and device classes such as MPU6050 build
+// as plain C++ on Linux: time, delays, PROGMEM access and a stdout Serial
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "I2Cdev.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT && !defined(ARDUINO)
+
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+I2CdevHostSerial Serial;
+
+static uint64_t monotonicMicros() {
+    static uint64_t origin = 0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t us = (uint64_t)now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+    if (!origin) origin = us;
+    return us - origin;
+}
+
+uint32_t millis() {
+    return (uint32_t)(monotonicMicros() / 1000);
+}
+
+uint32_t micros() {
+    return (uint32_t)monotonicMicros();
+}
+
+void delay(uint32_t ms) {
+    delayMicroseconds(ms * 1000UL);
+}
+
+void delayMicroseconds(uint32_t us) {
+    struct timespec duration = { (time_t)(us / 1000000UL), (long)(us % 1000000UL) * 1000L };
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR);
+}
+
+void I2CdevHostSerial::write(uint8_t c) {
+    putchar(c);
+}
+
+void I2CdevHostSerial::print(const char *s) {
+    fputs(s, stdout);
+}
+
+void I2CdevHostSerial::print(char c) {
+    putchar(c);
+}
+
+void I2CdevHostSerial::print(long n, int base) {
+    if (base == HEX) printf("%lX", (unsigned long)n);
+    else printf("%ld", n);
+}
+
+void I2CdevHostSerial::print(unsigned long n, int base) {
+    printf(base == HEX ? "%lX" : "%lu", n);
+}
+
+void I2CdevHostSerial::print(double f, int digits) {
+    printf("%.*f", digits, f);
+}
+
+#endif /* I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT && !ARDUINO */
@@ -0,0 +1,91 @@
+// I2Cdev library collection - the few Arduino core calls device classes use, for hosts without one
+// Lets I2Cdev with I2CDEV_TRANSPORT and device classes such as MPU6050 build
+// as plain C++ on Linux: time, delays, PROGMEM access and a stdout Serial
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _I2CDEV_HOST_H_
+#define _I2CDEV_HOST_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef PI
+    #define PI 3.1415926535897932384626433832795
+#endif
+
+#define DEC 10
+#define HEX 16
+
+// PROGMEM is plain memory; same include guard as the Teensy/ESP pgmspace.h, so
+// the MotionApps sources skip their own fallback definitions
+#ifndef __PGMSPACE_H_
+    #define __PGMSPACE_H_ 1
+    #define PROGMEM
+    #define PGM_P  const char *
+    #define PSTR(str) (str)
+    #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+    #define pgm_read_word(addr) (*(const unsigned short *)(addr))
+    #define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+    #define pgm_read_float(addr) (*(const float *)(addr))
+    #define pgm_read_byte_near(addr) pgm_read_byte(addr)
+    #define pgm_read_word_near(addr) pgm_read_word(addr)
+    #define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#endif
+
+// monotonic, from the first call; wrap like the Arduino counters
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+/** Serial as far as the device classes print: to stdout. */
+class I2CdevHostSerial {
+    public:
+        void write(uint8_t c);
+        void print(const char *s);
+        void print(char c);
+        void print(long n, int base=DEC);
+        void print(unsigned long n, int base=DEC);
+        void print(int n, int base=DEC) { print((long)n, base); }
+        void print(unsigned int n, int base=DEC) { print((unsigned long)n, base); }
+        void print(double f, int digits=2);
+        void println() { print("\n"); }
+        template <class T> void println(T value) { print(value); println(); }
+        template <class T> void println(T value, int format) { print(value, format); println(); }
+};
+
+extern I2CdevHostSerial Serial;
+
+#endif /* _I2CDEV_HOST_H_ */
@@ -0,0 +1,127 @@
+// I2Cdev library collection - Linux i2c-dev backend for I2CdevTransport
+// Drives a /dev/i2c-N adapter from user space with I2C_RDWR, so device
+// classes run unchanged on single-board computers
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "I2Cdev.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT && defined(__linux__)
+
+#include "I2CdevLinux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+I2CdevLinux::I2CdevLinux() : lastError(0), fd(-1) {
+}
+
+I2CdevLinux::~I2CdevLinux() {
+    close();
+}
+
+/** Open /dev/i2c-[bus].
+ * @return True when the adapter is open and supports plain I2C transfers
+ */
+bool I2CdevLinux::open(uint8_t bus) {
+    char path[16];
+    snprintf(path, sizeof(path), "/dev/i2c-%u", bus);
+    return open(path);
+}
+
+bool I2CdevLinux::open(const char *path) {
+    close();
+    fd = ::open(path, O_RDWR);
+    if (fd < 0) {
+        lastError = errno;
+        return false;
+    }
+    unsigned long funcs = 0;
+    if (ioctl(fd, I2C_FUNCS, &funcs) < 0) {
+        lastError = errno;
+    } else if (!(funcs & I2C_FUNC_I2C)) {
+        lastError = EOPNOTSUPP; // SMBus-only adapters cannot do I2C_RDWR
+    } else {
+        lastError = 0;
+        return true;
+    }
+    close();
+    return false;
+}
+
+void I2CdevLinux::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+bool I2CdevLinux::transferRead(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length) {
+    struct i2c_msg messages[2];
+    messages[0].addr = devAddr;
+    messages[0].flags = 0;
+    messages[0].len = 1;
+    messages[0].buf = &regAddr;
+    messages[1].addr = devAddr;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len = length;
+    messages[1].buf = data;
+    struct i2c_rdwr_ioctl_data transfer = { messages, 2 };
+    if (ioctl(fd, I2C_RDWR, &transfer) != 2) {
+        lastError = fd < 0 ? EBADF : errno;
+        return false;
+    }
+    return true;
+}
+
+bool I2CdevLinux::transferWrite(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length) {
+    if (length > I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) {
+        lastError = EMSGSIZE;
+        return false;
+    }
+    uint8_t buffer[I2CDEVLIB_WIRE_BUFFER_LENGTH];
+    buffer[0] = regAddr;
+    memcpy(buffer + 1, data, length);
+    struct i2c_msg message;
+    message.addr = devAddr;
+    message.flags = 0;
+    message.len = length + 1;
+    message.buf = buffer;
+    struct i2c_rdwr_ioctl_data transfer = { &message, 1 };
+    if (ioctl(fd, I2C_RDWR, &transfer) != 1) {
+        lastError = fd < 0 ? EBADF : errno;
+        return false;
+    }
+    return true;
+}
+
+#endif /* I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT && __linux__ */
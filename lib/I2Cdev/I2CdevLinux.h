@@ -0,0 +1,63 @@
+// I2Cdev library collection - Linux i2c-dev backend for I2CdevTransport
+// Drives a /dev/i2c-N adapter from user space with I2C_RDWR, so device
+// classes run unchanged on single-board computers
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _I2CDEV_LINUX_H_
+#define _I2CDEV_LINUX_H_
+
+#include "I2CdevTransport.h"
+
+/** I2CdevTransport over a Linux I2C adapter (/dev/i2c-N).
+ * Each register read is a single I2C_RDWR ioctl of two messages (address
+ * write, then read after a repeated START), so the kernel runs it as one
+ * combined transaction; each write is one message. The caller needs read
+ * and write access to the device node (usually the i2c group).
+ */
+class I2CdevLinux : public I2CdevTransport {
+    public:
+        I2CdevLinux();
+        ~I2CdevLinux();
+
+        bool open(uint8_t bus);
+        bool open(const char *path);
+        void close();
+        bool isOpen() const { return fd >= 0; }
+
+        int lastError;              // errno of the last failed open or transfer, 0 if none
+
+    protected:
+        bool transferRead(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length);
+        bool transferWrite(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length);
+
+    private:
+        int fd;
+};
+
+#endif /* _I2CDEV_LINUX_H_ */
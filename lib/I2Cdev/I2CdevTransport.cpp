@@ -0,0 +1,89 @@
+// I2Cdev library collection - pluggable I2C transport
+// Abstracts register reads and writes behind an object, so device classes can
+// run over something other than an Arduino Wire bus
+//
+// Changelog:
+//      2026-10-17 - initial release: interface with counters, Linux i2c-dev and in-process fake backends
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "I2Cdev.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT
+
+I2CdevTransport *I2CdevTransport::defaultTransport = 0;
+
+I2CdevTransport::I2CdevTransport() {
+    resetStats();
+}
+
+/** Read consecutive registers in one combined transaction.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register to read from
+ * @param data Buffer to store read data in
+ * @param length Number of bytes to read
+ * @return Status of operation (true = success)
+ */
+bool I2CdevTransport::read(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length) {
+    uint32_t startedAt = micros();
+    bool ok = transferRead(devAddr, regAddr, data, length);
+    if (ok) bytesRead += length;
+    count(ok, startedAt);
+    return ok;
+}
+
+/** Write consecutive registers in one transaction.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register to write to
+ * @param data Buffer to copy new data from
+ * @param length Number of bytes to write
+ * @return Status of operation (true = success)
+ */
+bool I2CdevTransport::write(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length) {
+    uint32_t startedAt = micros();
+    bool ok = transferWrite(devAddr, regAddr, data, length);
+    if (ok) bytesWritten += length;
+    count(ok, startedAt);
+    return ok;
+}
+
+void I2CdevTransport::resetStats() {
+    transactions = 0;
+    failures = 0;
+    bytesWritten = 0;
+    bytesRead = 0;
+    transferMicros = 0;
+    worstMicros = 0;
+}
+
+void I2CdevTransport::count(bool ok, uint32_t startedAt) {
+    uint32_t elapsed = micros() - startedAt;
+    transactions++;
+    if (!ok) failures++;
+    transferMicros += elapsed;
+    if (elapsed > worstMicros) worstMicros = elapsed;
+}
+
+#endif /* I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT */
@@ -0,0 +1,78 @@
+// I2Cdev library collection - pluggable I2C transport
+// Abstracts register reads and writes behind an object, so device classes can
+// run over something other than an Arduino Wire bus
+//
+// Changelog:
+//      2026-10-17 - initial release: interface with counters, Linux i2c-dev and in-process fake backends
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2013 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _I2CDEV_TRANSPORT_H_
+#define _I2CDEV_TRANSPORT_H_
+
+#include <stdint.h>
+
+/** An I2C master that moves register reads and writes as whole transactions.
+ * Selected with I2CDEV_IMPLEMENTATION == I2CDEV_TRANSPORT. Device classes then
+ * take an I2CdevTransport* where they would take a TwoWire* (the wireObj
+ * argument), or use I2CdevTransport::defaultTransport when given none.
+ * A register read is one combined transaction (address write, repeated
+ * START, data read), a register write is one transaction; backends implement
+ * both and this class counts them and the time spent in them.
+ */
+class I2CdevTransport {
+    public:
+        I2CdevTransport();
+        virtual ~I2CdevTransport() {}
+
+        bool read(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length);
+        bool write(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length);
+
+        void resetStats();
+
+        uint32_t transactions;
+        uint32_t failures;
+        uint32_t bytesWritten;      // payload after the register address
+        uint32_t bytesRead;
+        uint32_t transferMicros;    // total micros() spent inside transfers
+        uint32_t worstMicros;       // longest single transfer
+
+        // used by I2Cdev when a device object was given no wireObj
+        static I2CdevTransport *defaultTransport;
+
+        // the transport behind a device's wireObj argument
+        static I2CdevTransport *resolve(void *wireObj) {
+            return wireObj ? (I2CdevTransport *)wireObj : defaultTransport;
+        }
+
+    protected:
+        virtual bool transferRead(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t length) = 0;
+        virtual bool transferWrite(uint8_t devAddr, uint8_t regAddr, const uint8_t *data, uint16_t length) = 0;
+
+    private:
+        void count(bool ok, uint32_t startedAt);
+};
+
+#endif /* _I2CDEV_TRANSPORT_H_ */
@@ -3065,112 +3065,120 @@ uint8_t MPU6050_Base::readMemoryByte() {
 void MPU6050_Base::writeMemoryByte(uint8_t data) {
     I2Cdev::writeByte(devAddr, MPU6050_RA_MEM_R_W, data, wireObj);
 }
-void MPU6050_Base::readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address) {
-    setMemoryBank(bank);
-    setMemoryStartAddress(address);
+/** Set BANK_SEL and MEM_START_ADDR (adjacent registers) in one transaction.
+ * Leaves prefetch and the user bank disabled, as the DMP memory functions expect.
+ */
+void MPU6050_Base::setMemoryPointer(uint8_t bank, uint8_t address) {
+    buffer[0] = bank & 0x1F;
+    buffer[1] = address;
+    I2Cdev::writeBytes(devAddr, MPU6050_RA_BANK_SEL, 2, buffer, wireObj);
+}
+// CRC-16/XMODEM (poly 0x1021, init 0), as avr-libc's _crc_xmodem_update
+static uint16_t memoryCrcUpdate(uint16_t crc, const uint8_t *data, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        #ifdef __AVR__
+            crc = _crc_xmodem_update(crc, data[i]);
+        #else
+            crc ^= (uint16_t)data[i] << 8;
+            for (uint8_t bit = 0; bit < 8; bit++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        #endif
+    }
+    return crc;
+}
+/** Check a block of DMP memory against a known CRC, reading it back in
+ * bursts as large as the Wire buffer allows. The DMP has no checksum of its
+ * own, so this is how an upload is verified: against a CRC computed once
+ * (a firmware image's IMAGE_CRC trait, or the one writeMemoryBlock()
+ * accumulates), instead of comparing chunk by chunk.
+ * @param crc Expected CRC-16/XMODEM of the block
+ * @param dataSize Number of bytes
+ * @param bank Starting memory bank
+ * @param address Starting address within the bank
+ * @return True if every burst was read in full and the CRC matched
+ */
+bool MPU6050_Base::verifyMemoryBlock(uint16_t crc, uint16_t dataSize, uint8_t bank, uint8_t address) {
+    uint8_t chunk[MPU6050_DMP_MEMORY_BURST_SIZE];
     uint8_t chunkSize;
+    uint16_t actual = 0;
     for (uint16_t i = 0; i < dataSize;) {
-        // determine correct chunk size according to bank position and data size
-        chunkSize = MPU6050_DMP_MEMORY_CHUNK_SIZE;
+        if (i == 0 || address == 0) setMemoryPointer(bank, address);
 
-        // make sure we don't go past the data size
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
         if (i + chunkSize > dataSize) chunkSize = dataSize - i;
+        if (chunkSize > 256 - address) chunkSize = 256 - address;
+
+        if ((uint8_t)I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, chunk, I2Cdev::readTimeout, wireObj) != chunkSize) return false;
+        actual = memoryCrcUpdate(actual, chunk, chunkSize);
+
+        i += chunkSize;
+        address += chunkSize;
+        if (address == 0) bank++;
+    }
+    return actual == crc;
+}
+void MPU6050_Base::readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address) {
+    uint8_t chunkSize;
+    for (uint16_t i = 0; i < dataSize;) {
+        // the memory address auto-increments within a bank, so only point it
+        // at the start and after crossing into the next bank
+        if (i == 0 || address == 0) setMemoryPointer(bank, address);
 
-        // make sure this chunk doesn't go past the bank boundary (256 bytes)
+        // as much as the Wire buffer takes, without going past the data size
+        // or the bank boundary (256 bytes)
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
+        if (i + chunkSize > dataSize) chunkSize = dataSize - i;
         if (chunkSize > 256 - address) chunkSize = 256 - address;
 
-        // read the chunk of data as specified
         I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, data + i, I2Cdev::readTimeout, wireObj);
-        
-        // increase byte index by [chunkSize]
-        i += chunkSize;
 
+        i += chunkSize;
         // uint8_t automatically wraps to 0 at 256
         address += chunkSize;
-
-        // if we aren't done, update bank (if necessary) and address
-        if (i < dataSize) {
-            if (address == 0) bank++;
-            setMemoryBank(bank);
-            setMemoryStartAddress(address);
-        }
+        if (address == 0) bank++;
     }
 }
+/** Write a block to DMP memory in bursts as large as the Wire buffer allows.
+ * Bursts never cross a bank boundary; the memory pointer is only set at the
+ * start and at each bank boundary. With verify, a CRC-16 of the data is
+ * accumulated during the upload and checked by one streamed readback of the
+ * block (see verifyMemoryBlock()), instead of re-addressing and comparing
+ * every chunk. Firmware images carry a precomputed CRC; upload those without
+ * verify and call verifyMemoryBlock() with it.
+ * @param data Block to write (RAM, or flash with useProgMem)
+ * @param dataSize Number of bytes
+ * @param bank Starting memory bank
+ * @param address Starting address within the bank
+ * @param verify Read the block back and check its CRC
+ * @param useProgMem Data is in PROGMEM
+ * @return True if every burst was acknowledged and the CRC matched
+ */
 bool MPU6050_Base::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify, bool useProgMem) {
-    setMemoryBank(bank);
-    setMemoryStartAddress(address);
+    uint8_t chunk[MPU6050_DMP_MEMORY_BURST_SIZE];
+    const uint8_t *source;
     uint8_t chunkSize;
-    uint8_t *verifyBuffer=0;
-    uint8_t *progBuffer=0;
-    uint16_t i;
-    uint8_t j;
-    if (verify) verifyBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_CHUNK_SIZE);
-    if (useProgMem) progBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_CHUNK_SIZE);
-    for (i = 0; i < dataSize;) {
-        // determine correct chunk size according to bank position and data size
-        chunkSize = MPU6050_DMP_MEMORY_CHUNK_SIZE;
+    uint8_t startBank = bank, startAddress = address;
+    uint16_t crc = 0;
+    for (uint16_t i = 0; i < dataSize;) {
+        if (i == 0 || address == 0) setMemoryPointer(bank, address);
 
-        // make sure we don't go past the data size
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
         if (i + chunkSize > dataSize) chunkSize = dataSize - i;
-
-        // make sure this chunk doesn't go past the bank boundary (256 bytes)
         if (chunkSize > 256 - address) chunkSize = 256 - address;
-        
+
         if (useProgMem) {
-            // write the chunk of data as specified
-            for (j = 0; j < chunkSize; j++) progBuffer[j] = pgm_read_byte(data + i + j);
+            memcpy_P(chunk, data + i, chunkSize);
+            source = chunk;
         } else {
-            // write the chunk of data as specified
-            progBuffer = (uint8_t *)data + i;
-        }
-
-        I2Cdev::writeBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, progBuffer, wireObj);
-
-        // verify data if needed
-        if (verify && verifyBuffer) {
-            setMemoryBank(bank);
-            setMemoryStartAddress(address);
-            I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, verifyBuffer, I2Cdev::readTimeout, wireObj);
-            if (memcmp(progBuffer, verifyBuffer, chunkSize) != 0) {
-                /*Serial.print("Block write verification error, bank ");
-                Serial.print(bank, DEC);
-                Serial.print(", address ");
-                Serial.print(address, DEC);
-                Serial.print("!\nExpected:");
-                for (j = 0; j < chunkSize; j++) {
-                    Serial.print(" 0x");
-                    if (progBuffer[j] < 16) Serial.print("0");
-                    Serial.print(progBuffer[j], HEX);
-                }
-                Serial.print("\nReceived:");
-                for (uint8_t j = 0; j < chunkSize; j++) {
-                    Serial.print(" 0x");
-                    if (verifyBuffer[i + j] < 16) Serial.print("0");
-                    Serial.print(verifyBuffer[i + j], HEX);
-                }
-                Serial.print("\n");*/
-                free(verifyBuffer);
-                if (useProgMem) free(progBuffer);
-                return false; // uh oh.
-            }
+            source = data + i;
         }
+        if (!I2Cdev::writeBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, (uint8_t *)source, wireObj)) return false;
+        if (verify) crc = memoryCrcUpdate(crc, source, chunkSize);
 
-        // increase byte index by [chunkSize]
         i += chunkSize;
-
-        // uint8_t automatically wraps to 0 at 256
         address += chunkSize;
-
-        // if we aren't done, update bank (if necessary) and address
-        if (i < dataSize) {
-            if (address == 0) bank++;
-            setMemoryBank(bank);
-            setMemoryStartAddress(address);
-        }
+        if (address == 0) bank++;
     }
-    if (verify) free(verifyBuffer);
-    if (useProgMem) free(progBuffer);
-    return true;
+    return !verify || verifyMemoryBlock(crc, dataSize, startBank, startAddress);
 }
 bool MPU6050_Base::writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify) {
     return writeMemoryBlock(data, dataSize, bank, address, verify, true);
@@ -3275,6 +3283,47 @@ void MPU6050_Base::setDMPConfig2(uint8_t config) {
     I2Cdev::writeByte(devAddr, MPU6050_RA_DMP_CFG_2, config, wireObj);
 }
 
+// Burst transactions
+
+/** Read three consecutive axis words (X, Y, Z) in a single I2C transaction.
+ * Covers both the packed sensor/offset layout (stride 2, e.g. ACCEL_XOUT_H or
+ * XG_OFFS_USRH) and the MPU6500 accel offset layout (stride 3, 0x77/0x7A/0x7D).
+ * @param regAddr Address of the X axis high byte
+ * @param data Container for the X, Y, Z values
+ * @param stride Register distance between consecutive axes (2 or 3)
+ * @return True if all bytes were read; on failure data is left unchanged
+ */
+bool MPU6050_Base::getAxisWords(uint8_t regAddr, int16_t *data, uint8_t stride) {
+    uint8_t raw[8];
+    uint8_t length = stride * 2 + 2;
+    if ((uint8_t)I2Cdev::readBytes(devAddr, regAddr, length, raw, I2Cdev::readTimeout, wireObj) != length) return false;
+    for (uint8_t i = 0; i < 3; i++) {
+        data[i] = (((int16_t)raw[i * stride]) << 8) | raw[i * stride + 1];
+    }
+    return true;
+}
+
+/** Write three consecutive axis words (X, Y, Z).
+ * Packed registers (stride 2) go out in a single I2C transaction. With a
+ * stride of 3 the bytes between the words belong to other registers, so each
+ * axis is written on its own.
+ * @param regAddr Address of the X axis high byte
+ * @param data New X, Y, Z values
+ * @param stride Register distance between consecutive axes (2 or 3)
+ * @see getAxisWords()
+ */
+void MPU6050_Base::setAxisWords(uint8_t regAddr, const int16_t *data, uint8_t stride) {
+    if (stride != 2) {
+        for (uint8_t i = 0; i < 3; i++) I2Cdev::writeWord(devAddr, regAddr + i * stride, data[i], wireObj);
+        return;
+    }
+    uint8_t raw[6];
+    for (uint8_t i = 0; i < 3; i++) {
+        raw[i * 2] = (uint8_t)(data[i] >> 8);
+        raw[i * 2 + 1] = (uint8_t)data[i];
+    }
+    I2Cdev::writeBytes(devAddr, regAddr, 6, raw, wireObj);
+}
 
 //***************************************************************************************
 //**********************           Calibration Routines            **********************
@@ -3310,7 +3359,7 @@ void MPU6050_Base::CalibrateAccel(uint8_t Loops ) {
 void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 	uint8_t SaveAddress = (ReadAddress == 0x3B)?((getDeviceID() < 0x38 )? 0x06:0x77):0x13;
 
-	int16_t  Data;
+	int16_t  Data[3];
 	float Reading;
 	int16_t BitZero[3];
 	uint8_t shift =(SaveAddress == 0x77)?3:2;
@@ -3320,11 +3369,11 @@ void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 	uint16_t gravity = 8192; // prevent uninitialized compiler warning
 	if (ReadAddress == 0x3B) gravity = 16384 >> getFullScaleAccelRange();
 	Serial.write('>');
+	if (!getAxisWords(SaveAddress, Data, shift)) return; // all three offsets in one burst; no read, nothing to start from
 	for (int i = 0; i < 3; i++) {
-		I2Cdev::readWords(devAddr, SaveAddress + (i * shift), 1, (uint16_t *)&Data, I2Cdev::readTimeout, wireObj); // reads 1 or more 16 bit integers (Word)
-		Reading = Data;
+		Reading = Data[i];
 		if(SaveAddress != 0x13){
-			BitZero[i] = Data & 1;										 // Capture Bit Zero to properly handle Accelerometer calibration
+			BitZero[i] = Data[i] & 1;									 // Capture Bit Zero to properly handle Accelerometer calibration
 			ITerm[i] = ((float)Reading) * 8;
 			} else {
 			ITerm[i] = Reading * 4;
@@ -3334,20 +3383,23 @@ void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 		eSample = 0;
 		for (int c = 0; c < 100; c++) {// 100 PI Calculations
 			eSum = 0;
+			if (!getAxisWords(ReadAddress, Data)) { // X, Y, Z sensor readings in one burst
+				delay(1);								// failed read: skip this step rather than integrate it
+				continue;
+			}
 			for (int i = 0; i < 3; i++) {
-				I2Cdev::readWords(devAddr, ReadAddress + (i * 2), 1, (uint16_t *)&Data, I2Cdev::readTimeout, wireObj); // reads 1 or more 16 bit integers (Word)
-				Reading = Data;
+				Reading = Data[i];
 				if ((ReadAddress == 0x3B)&&(i == 2)) Reading -= gravity;	//remove Gravity
 				Error = -Reading;
 				eSum += abs(Reading);
 				PTerm = kP * Error;
 				ITerm[i] += (Error * 0.001) * kI;				// Integral term 1000 Calculations a second = 0.001
 				if(SaveAddress != 0x13){
-					Data = round((PTerm + ITerm[i] ) / 8);		//Compute PID Output
-					Data = ((Data)&0xFFFE) |BitZero[i];			// Insert Bit0 Saved at beginning
-				} else Data = round((PTerm + ITerm[i] ) / 4);	//Compute PID Output
-				I2Cdev::writeWords(devAddr, SaveAddress + (i * shift), 1, (uint16_t *)&Data, wireObj);
+					Data[i] = round((PTerm + ITerm[i] ) / 8);		//Compute PID Output
+					Data[i] = ((Data[i])&0xFFFE) |BitZero[i];		// Insert Bit0 Saved at beginning
+				} else Data[i] = round((PTerm + ITerm[i] ) / 4);	//Compute PID Output
 			}
+			setAxisWords(SaveAddress, Data, shift); // and the three new offsets in one more
 			if((c == 99) && eSum > 1000){						// Error is still to great to continue 
 				c = 0;
 				Serial.write('*');
@@ -3361,11 +3413,11 @@ void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 		kI *= .75;
 		for (int i = 0; i < 3; i++){
 			if(SaveAddress != 0x13) {
-				Data = round((ITerm[i] ) / 8);		//Compute PID Output
-				Data = ((Data)&0xFFFE) |BitZero[i];	// Insert Bit0 Saved at beginning
-			} else Data = round((ITerm[i]) / 4);
-			I2Cdev::writeWords(devAddr, SaveAddress + (i * shift), 1, (uint16_t *)&Data, wireObj);
+				Data[i] = round((ITerm[i] ) / 8);		//Compute PID Output
+				Data[i] = ((Data[i])&0xFFFE) |BitZero[i];	// Insert Bit0 Saved at beginning
+			} else Data[i] = round((ITerm[i]) / 4);
 		}
+		setAxisWords(SaveAddress, Data, shift);
 	}
 	resetFIFO();
 	resetDMP();
@@ -3373,13 +3425,8 @@ void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 
 int16_t * MPU6050_Base::GetActiveOffsets() {
     uint8_t AOffsetRegister = (getDeviceID() < 0x38 )? MPU6050_RA_XA_OFFS_H:0x77;
-    if(AOffsetRegister == 0x06)	I2Cdev::readWords(devAddr, AOffsetRegister, 3, (uint16_t *)offsets, I2Cdev::readTimeout, wireObj);
-    else {
-        I2Cdev::readWords(devAddr, AOffsetRegister, 1, (uint16_t *)offsets, I2Cdev::readTimeout, wireObj);
-        I2Cdev::readWords(devAddr, AOffsetRegister+3, 1, (uint16_t *)(offsets+1), I2Cdev::readTimeout, wireObj);
-        I2Cdev::readWords(devAddr, AOffsetRegister+6, 1, (uint16_t *)(offsets+2), I2Cdev::readTimeout, wireObj);
-    }
-    I2Cdev::readWords(devAddr, 0x13, 3, (uint16_t *)(offsets+3), I2Cdev::readTimeout, wireObj);
+    getAxisWords(AOffsetRegister, offsets, (AOffsetRegister == 0x06) ? 2 : 3);
+    getAxisWords(0x13, offsets+3);
     return offsets;
 }
 
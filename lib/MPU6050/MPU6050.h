@@ -46,6 +46,7 @@ THE SOFTWARE.
 
 #ifdef __AVR__
 #include <avr/pgmspace.h>
+#include <util/crc16.h>
 #elif defined(ESP32)
     #include <pgmspace.h>
 #else
@@ -434,6 +435,22 @@ THE SOFTWARE.
 #define MPU6050_DMP_MEMORY_BANKS        8
 #define MPU6050_DMP_MEMORY_BANK_SIZE    256
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
+// DMP memory transfers go in bursts as large as the platform's Wire buffer
+// takes: the buffer less the register address byte, at most 254 bytes so a
+// full burst's count is never mistaken for readBytes()'s -1 (0xFF)
+#if I2CDEVLIB_WIRE_BUFFER_LENGTH > 255
+    #define MPU6050_DMP_MEMORY_BURST_SIZE   254
+#else
+    #define MPU6050_DMP_MEMORY_BURST_SIZE   (I2CDEVLIB_WIRE_BUFFER_LENGTH - 1)
+#endif
+
+#define MPU6050_FIFO_SIZE           1024
+// FIFO drains go in reads of a whole Wire buffer, at most 255 bytes
+#if I2CDEVLIB_WIRE_BUFFER_LENGTH > 255
+    #define MPU6050_FIFO_BURST_SIZE     255
+#else
+    #define MPU6050_FIFO_BURST_SIZE     I2CDEVLIB_WIRE_BUFFER_LENGTH
+#endif
 
 #define MPU6050_FIFO_DEFAULT_TIMEOUT 11000
 
@@ -815,6 +832,7 @@ class MPU6050_Base {
         void readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
         bool writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true, bool useProgMem=false);
         bool writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true);
+        bool verifyMemoryBlock(uint16_t crc, uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
 
         bool writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem=false);
         bool writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize);
@@ -827,6 +845,10 @@ class MPU6050_Base {
         uint8_t getDMPConfig2();
         void setDMPConfig2(uint8_t config);
 
+        // Burst transactions on X/Y/Z word triplets
+        bool getAxisWords(uint8_t regAddr, int16_t *data, uint8_t stride=2);
+        void setAxisWords(uint8_t regAddr, const int16_t *data, uint8_t stride=2);
+
 		// Calibration Routines
 		void CalibrateGyro(uint8_t Loops = 15); // Fine tune after setting offsets with less Loops.
 		void CalibrateAccel(uint8_t Loops = 15);// Fine tune after setting offsets with less Loops.
@@ -841,6 +863,7 @@ class MPU6050_Base {
         uint32_t fifoTimeout = MPU6050_FIFO_DEFAULT_TIMEOUT;
     
     private:
+        void setMemoryPointer(uint8_t bank, uint8_t address);
         int16_t offsets[6];
 };
 
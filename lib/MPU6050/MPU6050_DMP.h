@@ -0,0 +1,483 @@
+// I2Cdev library collection - MPU6050 I2C device class, DMP driver for any MotionApps firmware
+// Based on InvenSense MPU-6050 register map document rev. 2.0, 5/19/2011 (RM-MPU-6000A-00)
+// 10/3/2011 by Jeff Rowberg <jeff@rowberg.net>
+// Updates should (hopefully) always be available at https://github.com/jrowberg/i2cdevlib
+//
+// Changelog:
+//  2026/10/17 - one driver templated on the firmware, replacing the three MotionApps classes
+//  2026/10/17 - dmpReadPackets() drains several packets per FIFO burst into a MPU6050_DMPBatch
+//  2026/10/17 - MPU6050_DMP::Packet decodes and derives lazily, once per packet; derivations are static
+//  2026/10/17 - IMAGE_CRC trait: the firmware upload is verified against a precomputed CRC
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2012 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _MPU6050_DMP_H_
+#define _MPU6050_DMP_H_
+
+#include <string.h>
+#include "MPU6050.h"
+
+/* ================================================================================================ *
+ | Firmware traits: one struct per DMP image, describing its default FIFO packet. Offsets are byte  |
+ | positions in the packet; each quaternion component is a big-endian Q30 int32, each sensor axis   |
+ | is SENSOR_BYTES wide with the int16 reading in its first two bytes. A field the firmware does    |
+ | not send has offset -1. The image itself lives in flash, defined next to the firmware's          |
+ | dmpInitialize() in its own .cpp, so only the firmware actually used gets linked.                 |
+ * ================================================================================================ */
+
+/* MotionApps v2.0, 42-byte packet:
+ * [QUAT W][      ][QUAT X][      ][QUAT Y][      ][QUAT Z][      ][GYRO X][      ][GYRO Y][      ]
+ *   0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15  16  17  18  19  20  21  22  23
+ * [GYRO Z][      ][ACC X ][      ][ACC Y ][      ][ACC Z ][      ][      ]
+ *  24  25  26  27  28  29  30  31  32  33  34  35  36  37  38  39  40  41
+ */
+struct MPU6050_MotionApps20 {
+    enum {
+        IMAGE_SIZE      = 1929,
+        PACKET_SIZE     = 42,
+        QUAT            = 0,
+        GYRO            = 16,
+        ACCEL           = 28,
+        MAG             = -1,
+        SENSOR_BYTES    = 4,
+        ACCEL_ONE_G     = 8192,     // +1g in the packet's accel (2g full scale)
+        INTERVAL_US     = 10000,    // packet period at the image's FIFO rate divisor, 200 Hz / (1 + 1)
+    };
+    static const unsigned char image[IMAGE_SIZE];
+    static const uint16_t IMAGE_CRC = 0xBD80;   // CRC-16/XMODEM of image, precomputed; the upload's readback must match it
+};
+
+/* MotionApps v6.12, 28-byte packet:
+ * [QUAT W][      ][QUAT X][      ][QUAT Y][      ][QUAT Z][      ]
+ *   0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15
+ * [ACC X ][ACC Y ][ACC Z ][GYRO X][GYRO Y][GYRO Z]
+ *  16  17  18  19  20  21  22  23  24  25  26  27
+ */
+struct MPU6050_MotionApps612 {
+    enum {
+        IMAGE_SIZE      = 3062,
+        PACKET_SIZE     = 28,
+        QUAT            = 0,
+        GYRO            = 22,
+        ACCEL           = 16,
+        MAG             = -1,
+        SENSOR_BYTES    = 2,
+        ACCEL_ONE_G     = 16384,
+        INTERVAL_US     = 10000,
+    };
+    static const unsigned char image[IMAGE_SIZE];
+    static const uint16_t IMAGE_CRC = 0x6C9E;
+};
+
+/* MotionApps v4.1 (9-axis, external magnetometer), 48-byte packet:
+ * [QUAT W][      ][QUAT X][      ][QUAT Y][      ][QUAT Z][      ][GYRO X][      ][GYRO Y][      ]
+ *   0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15  16  17  18  19  20  21  22  23
+ * [GYRO Z][      ][MAG X ][MAG Y ][MAG Z ][ACC X ][      ][ACC Y ][      ][ACC Z ][      ][      ]
+ *  24  25  26  27  28  29  30  31  32  33  34  35  36  37  38  39  40  41  42  43  44  45  46  47
+ */
+struct MPU6050_MotionApps41 {
+    enum {
+        IMAGE_SIZE      = 1962,
+        PACKET_SIZE     = 48,
+        QUAT            = 0,
+        GYRO            = 16,
+        ACCEL           = 34,
+        MAG             = 28,       // 3 x int16, packed
+        SENSOR_BYTES    = 4,
+        ACCEL_ONE_G     = 4096,
+        INTERVAL_US     = 20000,    // 200 Hz / (1 + 3)
+    };
+    static const unsigned char image[IMAGE_SIZE];
+    static const uint16_t IMAGE_CRC = 0x6370;
+};
+
+/** DMP samples decoded by MPU6050_DMP::dmpReadPackets(), one array per field.
+ * Index i of every array is the same packet, oldest first; count says how
+ * many are valid. The quaternion is Q14 (1.0 = 16384), as from
+ * dmpGetQuaternion(int16_t*); gyro and accel are the raw int16 readings.
+ */
+template <uint8_t N>
+struct MPU6050_DMPBatch {
+    enum { CAPACITY = N };
+    uint8_t count;
+    uint32_t timestamp[N];      // micros(), estimated
+    int16_t quaternion[4][N];   // w, x, y, z
+    int16_t gyro[3][N];
+    int16_t accel[3][N];
+};
+
+/** DMP driver for one firmware image, chosen at compile time.
+ * Every offset and size comes from the Firmware traits, so decoding a packet
+ * compiles to fixed loads with no lookups or branches, and the packet size
+ * is a constant instead of something dmpInitialize() has to set first.
+ * dmpInitialize() differs per firmware and is specialized in that
+ * firmware's .cpp (MPU6050_6Axis_MotionApps20.cpp etc.).
+ */
+template <class FirmwareTraits>
+class MPU6050_DMP : public MPU6050_Base {
+    public:
+        typedef FirmwareTraits Firmware;
+        enum { PACKET_SIZE = Firmware::PACKET_SIZE };
+
+        MPU6050_DMP(uint8_t address=MPU6050_DEFAULT_ADDRESS, void *wireObj=0) : MPU6050_Base(address, wireObj), dmpPacketBuffer(0) { }
+
+        uint8_t dmpInitialize();
+        bool dmpPacketAvailable() { return getFIFOCount() >= PACKET_SIZE; }
+        uint16_t dmpGetFIFOPacketSize() { return PACKET_SIZE; }
+        uint8_t dmpGetCurrentFIFOPacket(uint8_t *data) { return GetCurrentFIFOPacket(data, PACKET_SIZE); } // overflow proof
+
+        /** Drain up to N whole packets from the FIFO and decode them in one pass.
+         * One FIFO count read, then the packets as back-to-back reads of
+         * MPU6050_FIFO_BURST_SIZE bytes that ignore packet boundaries, so n
+         * packets cost ceil(n * PACKET_SIZE / burst) reads instead of a count
+         * and ceil(PACKET_SIZE / burst) reads each. Every packet is decoded
+         * into batch as soon as its last byte is in, and never touched again.
+         * The FIFO carries no timestamps: the newest packet gets micros() at
+         * the count read, each older one packetInterval before it. Packets
+         * beyond N stay in the FIFO for the next call.
+         * @param batch Filled from index 0; batch.count is set to the return value
+         * @param packetInterval Microseconds between packets, if the FIFO rate divisor was changed
+         * @return Packets decoded, 0 also after resetting an overflowed FIFO
+         */
+        template <uint8_t N>
+        uint8_t dmpReadPackets(MPU6050_DMPBatch<N> *batch, uint32_t packetInterval=Firmware::INTERVAL_US) {
+            batch -> count = 0;
+            uint16_t fifoCount = getFIFOCount();
+            uint32_t now = micros();
+            if (fifoCount > MPU6050_FIFO_SIZE - PACKET_SIZE) {
+                resetFIFO(); // wrapped: the byte stream no longer starts on a packet boundary
+                return 0;
+            }
+            uint8_t packets = fifoCount / PACKET_SIZE < N ? fifoCount / PACKET_SIZE : N;
+
+            uint8_t buf[PACKET_SIZE - 1 + MPU6050_FIFO_BURST_SIZE];
+            uint16_t fill = 0; // bytes of a packet carried over from the previous read
+            for (uint16_t remaining = (uint16_t)packets * PACKET_SIZE; remaining > 0; ) {
+                uint8_t length = remaining < MPU6050_FIFO_BURST_SIZE ? remaining : MPU6050_FIFO_BURST_SIZE;
+                getFIFOBytes(buf + fill, length);
+                remaining -= length;
+                fill += length;
+                const uint8_t *packet = buf;
+                for (; fill >= PACKET_SIZE; fill -= PACKET_SIZE, packet += PACKET_SIZE) decodeInto(batch, packet);
+                if (fill && packet != buf) memmove(buf, packet, fill);
+            }
+            for (uint8_t i = 0; i < packets; i++) batch -> timestamp[i] = now - (uint32_t)(packets - 1 - i) * packetInterval;
+            return packets;
+        }
+
+        /** One FIFO packet, decoded and derived on first use only.
+         * Build one per packet and hand it to every consumer: each field is
+         * parsed from the big-endian bytes once and each derived value
+         * (gravity, yaw, pitch/roll, linear and world-frame accel) computed
+         * once, on first access, however many consumers ask for it. Values
+         * are those the dmpGet*() chain gives. The packet bytes must outlive
+         * the view.
+         */
+        class Packet {
+            public:
+                explicit Packet(const uint8_t *packet) : data(packet), cached(0) { }
+
+                const Quaternion &quaternion() {
+                    if (!(cached & QUATERNION)) {
+                        quaternionOf(&quat, data);
+                        cached |= QUATERNION;
+                    }
+                    return quat;
+                }
+                const VectorInt16 &accel() {
+                    if (!(cached & ACCEL)) {
+                        accelRaw.x = word16(data + Firmware::ACCEL);
+                        accelRaw.y = word16(data + Firmware::ACCEL + Firmware::SENSOR_BYTES);
+                        accelRaw.z = word16(data + Firmware::ACCEL + 2 * Firmware::SENSOR_BYTES);
+                        cached |= ACCEL;
+                    }
+                    return accelRaw;
+                }
+                const VectorInt16 &gyro() {
+                    if (!(cached & GYRO)) {
+                        gyroRaw.x = word16(data + Firmware::GYRO);
+                        gyroRaw.y = word16(data + Firmware::GYRO + Firmware::SENSOR_BYTES);
+                        gyroRaw.z = word16(data + Firmware::GYRO + 2 * Firmware::SENSOR_BYTES);
+                        cached |= GYRO;
+                    }
+                    return gyroRaw;
+                }
+                const VectorFloat &gravity() {
+                    if (!(cached & GRAVITY)) {
+                        dmpGetGravity(&grav, &quaternion());
+                        cached |= GRAVITY;
+                    }
+                    return grav;
+                }
+                // yaw alone needs neither gravity nor the two atan2() of pitch and roll
+                float yaw() {
+                    if (!(cached & YAW)) {
+                        ypr[0] = yawOf(&quaternion());
+                        cached |= YAW;
+                    }
+                    return ypr[0];
+                }
+                const float *yawPitchRoll() {
+                    if (!(cached & PITCH_ROLL)) {
+                        yaw();
+                        pitchRollOf(ypr, &gravity());
+                        cached |= PITCH_ROLL;
+                    }
+                    return ypr;
+                }
+                const VectorInt16 &linearAccel() {
+                    if (!(cached & LINEAR)) {
+                        dmpGetLinearAccel(&linear, &accel(), &gravity());
+                        cached |= LINEAR;
+                    }
+                    return linear;
+                }
+                const VectorInt16 &linearAccelInWorld() {
+                    if (!(cached & WORLD)) {
+                        linearAccel();
+                        quaternion();
+                        dmpGetLinearAccelInWorld(&world, &linear, &quat);
+                        cached |= WORLD;
+                    }
+                    return world;
+                }
+
+            private:
+                enum {
+                    QUATERNION  = 0x01,
+                    ACCEL       = 0x02,
+                    GYRO        = 0x04,
+                    GRAVITY     = 0x08,
+                    YAW         = 0x10,
+                    PITCH_ROLL  = 0x20,
+                    LINEAR      = 0x40,
+                    WORLD       = 0x80,
+                };
+                const uint8_t *data;
+                uint8_t cached;     // which of the values below are valid
+                Quaternion quat;
+                VectorInt16 accelRaw, gyroRaw, linear, world;
+                VectorFloat grav;
+                float ypr[3];
+        };
+
+        // Get Fixed Point data from FIFO
+        uint8_t dmpGetAccel(int32_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = sensor32(packet + Firmware::ACCEL);
+            data[1] = sensor32(packet + Firmware::ACCEL + Firmware::SENSOR_BYTES);
+            data[2] = sensor32(packet + Firmware::ACCEL + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetAccel(int16_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = word16(packet + Firmware::ACCEL);
+            data[1] = word16(packet + Firmware::ACCEL + Firmware::SENSOR_BYTES);
+            data[2] = word16(packet + Firmware::ACCEL + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetAccel(VectorInt16 *v, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            v -> x = word16(packet + Firmware::ACCEL);
+            v -> y = word16(packet + Firmware::ACCEL + Firmware::SENSOR_BYTES);
+            v -> z = word16(packet + Firmware::ACCEL + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetQuaternion(int32_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = word32(packet + Firmware::QUAT);
+            data[1] = word32(packet + Firmware::QUAT + 4);
+            data[2] = word32(packet + Firmware::QUAT + 8);
+            data[3] = word32(packet + Firmware::QUAT + 12);
+            return 0;
+        }
+        uint8_t dmpGetQuaternion(int16_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = word16(packet + Firmware::QUAT);
+            data[1] = word16(packet + Firmware::QUAT + 4);
+            data[2] = word16(packet + Firmware::QUAT + 8);
+            data[3] = word16(packet + Firmware::QUAT + 12);
+            return 0;
+        }
+        uint8_t dmpGetQuaternion(Quaternion *q, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            quaternionOf(q, packet);
+            return 0;
+        }
+        uint8_t dmpGetGyro(int32_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = sensor32(packet + Firmware::GYRO);
+            data[1] = sensor32(packet + Firmware::GYRO + Firmware::SENSOR_BYTES);
+            data[2] = sensor32(packet + Firmware::GYRO + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetGyro(int16_t *data, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = word16(packet + Firmware::GYRO);
+            data[1] = word16(packet + Firmware::GYRO + Firmware::SENSOR_BYTES);
+            data[2] = word16(packet + Firmware::GYRO + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetGyro(VectorInt16 *v, const uint8_t* packet=0) {
+            if (packet == 0) packet = dmpPacketBuffer;
+            v -> x = word16(packet + Firmware::GYRO);
+            v -> y = word16(packet + Firmware::GYRO + Firmware::SENSOR_BYTES);
+            v -> z = word16(packet + Firmware::GYRO + 2 * Firmware::SENSOR_BYTES);
+            return 0;
+        }
+        uint8_t dmpGetMag(int16_t *data, const uint8_t* packet=0) {
+            static_assert(Firmware::MAG >= 0, "this DMP firmware does not send magnetometer data");
+            if (packet == 0) packet = dmpPacketBuffer;
+            data[0] = word16(packet + Firmware::MAG);
+            data[1] = word16(packet + Firmware::MAG + 2);
+            data[2] = word16(packet + Firmware::MAG + 4);
+            return 0;
+        }
+        static uint8_t dmpGetLinearAccel(VectorInt16 *v, const VectorInt16 *vRaw, const VectorFloat *gravity) {
+            // get rid of the gravity component
+            HELPER_3DMATH_COUNT(linear);
+            v -> x = vRaw -> x - gravity -> x*Firmware::ACCEL_ONE_G;
+            v -> y = vRaw -> y - gravity -> y*Firmware::ACCEL_ONE_G;
+            v -> z = vRaw -> z - gravity -> z*Firmware::ACCEL_ONE_G;
+            return 0;
+        }
+        static uint8_t dmpGetLinearAccelInWorld(VectorInt16 *v, const VectorInt16 *vReal, Quaternion *q) {
+            // rotate measured 3D acceleration vector into original state
+            // frame of reference based on orientation quaternion
+            memcpy(v, vReal, sizeof(VectorInt16));
+            v -> rotate(q);
+            return 0;
+        }
+        uint8_t dmpGetGravity(int16_t *data, const uint8_t* packet=0) {
+            /* +1g corresponds to +8192 (half the Q14 quaternion scale). */
+            int16_t qI[4];
+            uint8_t status = dmpGetQuaternion(qI, packet);
+            data[0] = ((int32_t)qI[1] * qI[3] - (int32_t)qI[0] * qI[2]) / 16384;
+            data[1] = ((int32_t)qI[0] * qI[1] + (int32_t)qI[2] * qI[3]) / 16384;
+            data[2] = ((int32_t)qI[0] * qI[0] - (int32_t)qI[1] * qI[1]
+                - (int32_t)qI[2] * qI[2] + (int32_t)qI[3] * qI[3]) / (int32_t)(2 * 16384L);
+            return status;
+        }
+        static uint8_t dmpGetGravity(VectorFloat *v, const Quaternion *q) {
+            HELPER_3DMATH_COUNT(gravity);
+            v -> x = 2 * (q -> x*q -> z - q -> w*q -> y);
+            v -> y = 2 * (q -> w*q -> x + q -> y*q -> z);
+            v -> z = q -> w*q -> w - q -> x*q -> x - q -> y*q -> y + q -> z*q -> z;
+            return 0;
+        }
+
+        static uint8_t dmpGetEuler(float *data, const Quaternion *q) {
+            data[0] = atan2(2*q -> x*q -> y - 2*q -> w*q -> z, 2*q -> w*q -> w + 2*q -> x*q -> x - 1);   // psi
+            data[1] = -asin(2*q -> x*q -> z + 2*q -> w*q -> y);                              // theta
+            data[2] = atan2(2*q -> y*q -> z - 2*q -> w*q -> x, 2*q -> w*q -> w + 2*q -> z*q -> z - 1);   // phi
+            return 0;
+        }
+        static uint8_t dmpGetYawPitchRoll(float *data, const Quaternion *q, const VectorFloat *gravity) {
+            data[0] = yawOf(q);
+            pitchRollOf(data, gravity);
+            return 0;
+        }
+
+        uint8_t dmpProcessFIFOPacket(const unsigned char *dmpData) {
+            (void)dmpData; // unused parameter
+            return 0;
+        }
+        uint8_t dmpReadAndProcessFIFOPacket(uint8_t numPackets, uint8_t *processed=NULL) {
+            uint8_t status;
+            uint8_t buf[PACKET_SIZE];
+            for (uint8_t i = 0; i < numPackets; i++) {
+                // read packet from FIFO
+                getFIFOBytes(buf, PACKET_SIZE);
+
+                // process packet
+                if ((status = dmpProcessFIFOPacket(buf)) > 0) return status;
+
+                // increment external process count variable, if supplied
+                if (processed != 0) (*processed)++;
+            }
+            return 0;
+        }
+
+    private:
+        static void quaternionOf(Quaternion *q, const uint8_t *packet) {
+            // Q14 to float by the exact reciprocal: a multiply, where a divide costs several on AVR
+            HELPER_3DMATH_COUNT(quaternion);
+            q -> w = word16(packet + Firmware::QUAT) * (1.0f / 16384.0f);
+            q -> x = word16(packet + Firmware::QUAT + 4) * (1.0f / 16384.0f);
+            q -> y = word16(packet + Firmware::QUAT + 8) * (1.0f / 16384.0f);
+            q -> z = word16(packet + Firmware::QUAT + 12) * (1.0f / 16384.0f);
+        }
+        // yaw: (about Z axis)
+        static float yawOf(const Quaternion *q) {
+            HELPER_3DMATH_COUNT(yaw);
+            return atan2(2*q -> x*q -> y - 2*q -> w*q -> z, 2*q -> w*q -> w + 2*q -> x*q -> x - 1);
+        }
+        // pitch and roll into data[1] and data[2]
+        static void pitchRollOf(float *data, const VectorFloat *gravity) {
+            HELPER_3DMATH_COUNT(pitchRoll);
+#ifdef USE_OLD_DMPGETYAWPITCHROLL
+            // pitch: (nose up/down, about Y axis)
+            data[1] = atan(gravity -> x / sqrt(gravity -> y*gravity -> y + gravity -> z*gravity -> z));
+            // roll: (tilt left/right, about X axis)
+            data[2] = atan(gravity -> y / sqrt(gravity -> x*gravity -> x + gravity -> z*gravity -> z));
+#else
+            // pitch: (nose up/down, about Y axis)
+            data[1] = atan2(gravity -> x , sqrt(gravity -> y*gravity -> y + gravity -> z*gravity -> z));
+            // roll: (tilt left/right, about X axis)
+            data[2] = atan2(gravity -> y , gravity -> z);
+            if (gravity -> z < 0) {
+                if (data[1] > 0) {
+                    data[1] = PI - data[1];
+                } else {
+                    data[1] = -PI - data[1];
+                }
+            }
+#endif
+        }
+
+        static int16_t word16(const uint8_t *p) { return (int16_t)(((uint16_t)p[0] << 8) | p[1]); }
+        static int32_t word32(const uint8_t *p) {
+            return (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]);
+        }
+        // a sensor axis as int32: the whole word where the firmware sends 32 bits, the sign-extended reading otherwise
+        static int32_t sensor32(const uint8_t *p) { return Firmware::SENSOR_BYTES == 4 ? word32(p) : word16(p); }
+
+        template <uint8_t N> static void decodeInto(MPU6050_DMPBatch<N> *batch, const uint8_t *packet) {
+            uint8_t i = batch -> count++;
+            for (uint8_t k = 0; k < 4; k++) batch -> quaternion[k][i] = word16(packet + Firmware::QUAT + 4 * k);
+            for (uint8_t k = 0; k < 3; k++) {
+                batch -> gyro[k][i] = word16(packet + Firmware::GYRO + k * Firmware::SENSOR_BYTES);
+                batch -> accel[k][i] = word16(packet + Firmware::ACCEL + k * Firmware::SENSOR_BYTES);
+            }
+        }
+
+        uint8_t *dmpPacketBuffer;
+};
+
+template <> uint8_t MPU6050_DMP<MPU6050_MotionApps20>::dmpInitialize();
+template <> uint8_t MPU6050_DMP<MPU6050_MotionApps612>::dmpInitialize();
+template <> uint8_t MPU6050_DMP<MPU6050_MotionApps41>::dmpInitialize();
+
+#endif /* _MPU6050_DMP_H_ */
@@ -0,0 +1,194 @@
+// I2Cdev library collection - MPU6050 interrupt-driven DMP FIFO reader
+// Based on InvenSense MPU-6050 register map document rev. 2.0, 5/19/2011 (RM-MPU-6000A-00)
+//
+// Changelog:
+//  2026/10/17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2021 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "MPU6050_FIFOReader.h"
+
+// the INT pin handling needs an Arduino core; hosts without one poll with dmpReadPackets()
+#ifdef ARDUINO
+
+MPU6050_FIFOReader *MPU6050_FIFOReader::active = 0;
+
+/** Specific constructor.
+ * @param mpu Device whose DMP fills the FIFO
+ * @param packetSize DMP packet size, at most MPU6050_FIFOREADER_PACKET_SIZE
+ */
+MPU6050_FIFOReader::MPU6050_FIFOReader(MPU6050_Base &mpu, uint8_t packetSize) {
+    this->mpu = &mpu;
+    this->packetSize = (packetSize && packetSize <= MPU6050_FIFOREADER_PACKET_SIZE) ? packetSize : MPU6050_FIFOREADER_PACKET_SIZE;
+    intPin = 255;
+    interruptCount = transactions = packetsRead = packetsDropped = overflows = 0;
+    reset();
+}
+
+/** Attach to the MPU INT pin and start from an empty FIFO.
+ * Only one reader can own the interrupt at a time. The DMP interrupt must
+ * already be enabled (dmpInitialize() does this).
+ * @param intPin Arduino pin wired to the MPU INT output
+ */
+void MPU6050_FIFOReader::begin(uint8_t intPin) {
+    end();
+    this->intPin = intPin;
+    active = this;
+    mpu->resetFIFO();
+    transactions++;
+    reset();
+    pinMode(intPin, INPUT);
+    attachInterrupt(digitalPinToInterrupt(intPin), isr, RISING);
+}
+
+/** Detach from the INT pin. Packets already in the ring stay readable. */
+void MPU6050_FIFOReader::end() {
+    if (intPin != 255) detachInterrupt(digitalPinToInterrupt(intPin));
+    if (active == this) active = 0;
+    intPin = 255;
+}
+
+/** Forget all pending edges, the partial packet and the ring contents. */
+void MPU6050_FIFOReader::reset() {
+    noInterrupts();
+    stampHead = stampCount = 0;
+    interrupts();
+    fifoBytes = 0;
+    packetOffset = 0;
+    slotHead = slotCount = 0;
+}
+
+void MPU6050_FIFOReader::isr() {
+    MPU6050_FIFOReader *reader = active;
+    if (!reader) return;
+    uint8_t index = (reader->stampHead + reader->stampCount) & (MPU6050_FIFOREADER_STAMPS - 1);
+    reader->stamps[index] = micros();
+    if (reader->stampCount < MPU6050_FIFOREADER_STAMPS) reader->stampCount++;
+    else reader->stampHead = (reader->stampHead + 1) & (MPU6050_FIFOREADER_STAMPS - 1); // keep the newest
+    reader->interruptCount++;
+}
+
+/** Pop the oldest INT timestamp.
+ * @return False when no edge is pending
+ */
+bool MPU6050_FIFOReader::takeStamp(uint32_t *stamp) {
+    bool taken = false;
+    noInterrupts();
+    if (stampCount) {
+        *stamp = stamps[stampHead];
+        stampHead = (stampHead + 1) & (MPU6050_FIFOREADER_STAMPS - 1);
+        stampCount--;
+        taken = true;
+    }
+    interrupts();
+    return taken;
+}
+
+/** Advance the FIFO read by at most one I2C transaction.
+ * Does nothing (no bus traffic) while no INT edge is pending and no
+ * complete packet is known to be in the FIFO, so it is cheap to call on
+ * every pass of the main loop.
+ * @return True when a packet was completed on this call
+ */
+bool MPU6050_FIFOReader::poll() {
+    if (packetOffset == 0 && fifoBytes < packetSize) {
+        noInterrupts();
+        bool pending = stampCount != 0;
+        interrupts();
+        if (!pending) return false;
+
+        fifoBytes = mpu->getFIFOCount();
+        transactions++;
+        if (fifoBytes > MPU6050_FIFOREADER_OVERFLOW) {
+            // wrapped: the byte stream no longer starts on a packet boundary
+            mpu->resetFIFO();
+            transactions++;
+            overflows++;
+            fifoBytes = 0;
+            noInterrupts();
+            stampHead = stampCount = 0;
+            interrupts();
+            return false;
+        }
+        // edges for packets that are not in the FIFO (yet) are stale
+        uint8_t queued = fifoBytes / packetSize;
+        uint32_t stale;
+        while (stampCount > queued && takeStamp(&stale));
+        return false;
+    }
+
+    if (packetOffset == 0 && slotCount == MPU6050_FIFOREADER_SLOTS) {
+        // the next packet is filled in place over several slices; free its
+        // slot now so read()/peek() in between never see it half written
+        slotHead = (slotHead + 1) & (MPU6050_FIFOREADER_SLOTS - 1);
+        slotCount--;
+        packetsDropped++;
+    }
+    MPU6050_FIFOPacket *slot = &slots[(slotHead + slotCount) & (MPU6050_FIFOREADER_SLOTS - 1)];
+    uint8_t length = packetSize - packetOffset;
+    if (length > I2CDEVLIB_WIRE_BUFFER_LENGTH) length = I2CDEVLIB_WIRE_BUFFER_LENGTH;
+    mpu->getFIFOBytes(slot->data + packetOffset, length);
+    transactions++;
+    packetOffset += length;
+    fifoBytes -= length;
+    if (packetOffset < packetSize) return false;
+
+    packetOffset = 0;
+    if (!takeStamp(&slot->timestamp)) slot->timestamp = micros();
+    slotCount++;
+    packetsRead++;
+    return true;
+}
+
+/** Number of completed packets waiting in the ring. */
+uint8_t MPU6050_FIFOReader::available() const {
+    return slotCount;
+}
+
+/** Copy out and remove the oldest completed packet.
+ * @return False when the ring is empty
+ */
+bool MPU6050_FIFOReader::read(MPU6050_FIFOPacket *packet) {
+    if (!slotCount) return false;
+    memcpy(packet, &slots[slotHead], sizeof(MPU6050_FIFOPacket));
+    discard();
+    return true;
+}
+
+/** Oldest completed packet, valid until the next poll() or discard().
+ * @return 0 when the ring is empty
+ */
+const MPU6050_FIFOPacket *MPU6050_FIFOReader::peek() const {
+    return slotCount ? &slots[slotHead] : 0;
+}
+
+/** Remove the oldest completed packet. */
+void MPU6050_FIFOReader::discard() {
+    if (!slotCount) return;
+    slotHead = (slotHead + 1) & (MPU6050_FIFOREADER_SLOTS - 1);
+    slotCount--;
+}
+
+#endif /* ARDUINO */
@@ -0,0 +1,109 @@
+// I2Cdev library collection - MPU6050 interrupt-driven DMP FIFO reader
+// Based on InvenSense MPU-6050 register map document rev. 2.0, 5/19/2011 (RM-MPU-6000A-00)
+//
+// Changelog:
+//  2026/10/17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2021 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _MPU6050_FIFOREADER_H_
+#define _MPU6050_FIFOREADER_H_
+
+#include "MPU6050.h"
+
+// DMP packet size (42 bytes for MotionApps 2.0)
+#ifndef MPU6050_FIFOREADER_PACKET_SIZE
+    #define MPU6050_FIFOREADER_PACKET_SIZE  42
+#endif
+
+// completed packets kept for the caller, power of two
+#ifndef MPU6050_FIFOREADER_SLOTS
+    #define MPU6050_FIFOREADER_SLOTS        4
+#endif
+
+// INT edges remembered between two poll() calls, power of two
+#define MPU6050_FIFOREADER_STAMPS           8
+
+// above this many bytes the FIFO has wrapped and packet alignment is lost
+#define MPU6050_FIFOREADER_OVERFLOW         (1024 - MPU6050_FIFOREADER_PACKET_SIZE)
+
+struct MPU6050_FIFOPacket {
+    uint32_t timestamp;     // micros() at the INT edge that announced the packet
+    uint8_t data[MPU6050_FIFOREADER_PACKET_SIZE];
+};
+
+/** Non-blocking reader for the DMP packet stream.
+ * The INT pin ISR only timestamps the edge. All I2C traffic happens in
+ * poll(), which issues at most one bounded transaction per call (a FIFO count
+ * read or one Wire-buffer-sized slice of a packet) and never waits for data.
+ * Completed packets land in a small ring; when the caller falls behind the
+ * oldest one is dropped.
+ */
+class MPU6050_FIFOReader {
+    public:
+        MPU6050_FIFOReader(MPU6050_Base &mpu, uint8_t packetSize=MPU6050_FIFOREADER_PACKET_SIZE);
+
+        void begin(uint8_t intPin);
+        void end();
+        void reset();
+
+        bool poll();
+
+        uint8_t available() const;
+        bool read(MPU6050_FIFOPacket *packet);
+        const MPU6050_FIFOPacket *peek() const;
+        void discard();
+
+        uint32_t interruptCount;    // INT edges seen
+        uint32_t transactions;      // I2C transactions issued by poll()
+        uint32_t packetsRead;       // packets completed
+        uint32_t packetsDropped;    // completed packets dropped unread to make room
+        uint32_t overflows;         // FIFO resets after the hardware FIFO wrapped
+
+    private:
+        static void isr();
+        static MPU6050_FIFOReader *active;
+
+        bool takeStamp(uint32_t *stamp);
+
+        MPU6050_Base *mpu;
+        uint8_t packetSize;
+        uint8_t intPin;
+
+        // ISR side
+        volatile uint32_t stamps[MPU6050_FIFOREADER_STAMPS];
+        volatile uint8_t stampHead;
+        volatile uint8_t stampCount;
+
+        // read state: bytes known to be in the FIFO, bytes of the current packet read so far
+        uint16_t fifoBytes;
+        uint8_t packetOffset;
+
+        MPU6050_FIFOPacket slots[MPU6050_FIFOREADER_SLOTS];
+        uint8_t slotHead;
+        uint8_t slotCount;
+};
+
+#endif /* _MPU6050_FIFOREADER_H_ */
@@ -4,6 +4,7 @@
 //
 // Changelog:
 //     2012-06-05 - add 3D math helper file to DMP6 example sketch
+//     2026-10-17 - add Q16/Q30 fixed-point QuaternionFixed and VectorFixed
 
 /* ============================================
 I2Cdev device library code is placed under the MIT license
@@ -32,6 +33,26 @@ THE SOFTWARE.
 #ifndef _HELPER_3DMATH_H_
 #define _HELPER_3DMATH_H_
 
+#include <stdint.h>
+
+// Instrumented builds (-D HELPER_3DMATH_COUNTING, see bench/bench_dmp_packet.cpp)
+// count each float derivation the orientation code performs. The build that
+// sets the flag defines helper3dmathCounts. Otherwise the hook is empty.
+#ifdef HELPER_3DMATH_COUNTING
+struct Helper3dmathCounts {
+    uint32_t quaternion;    // Q14 words to a float quaternion
+    uint32_t gravity;       // gravity direction from a quaternion
+    uint32_t yaw;           // yaw from a quaternion
+    uint32_t pitchRoll;     // pitch and roll from gravity
+    uint32_t linear;        // gravity removed from the raw accel
+    uint32_t rotate;        // a vector rotated by a quaternion: two quaternion products
+};
+extern Helper3dmathCounts helper3dmathCounts;
+#define HELPER_3DMATH_COUNT(what) (helper3dmathCounts.what++)
+#else
+#define HELPER_3DMATH_COUNT(what)
+#endif
+
 class Quaternion {
     public:
         float w;
@@ -135,6 +156,7 @@ class VectorInt16 {
             // - q is the orientation quaternion
             // - P_in is the input vector (a*aReal)
             // - conj(q) is the conjugate of the orientation quaternion (q=[w,x,y,z], q*=[w,-x,-y,-z])
+            HELPER_3DMATH_COUNT(rotate);
             Quaternion p(0, x, y, z);
 
             // quaternion multiplication: q * p, stored back in p
@@ -192,6 +214,7 @@ class VectorFloat {
         }
         
         void rotate(Quaternion *q) {
+            HELPER_3DMATH_COUNT(rotate);
             Quaternion p(0, x, y, z);
 
             // quaternion multiplication: q * p, stored back in p
@@ -213,4 +236,259 @@ class VectorFloat {
         }
 };
 
+// ---------------------------------------------------------------------------
+// Fixed-point variants
+//
+// QuaternionFixed<F> and VectorFixed<F> hold components as int32_t with F
+// fractional bits. Two formats are provided:
+//   - Q30 is the DMP's native quaternion format (dmpGetQuaternion(int32_t *)),
+//     exact, with 64-bit intermediates. Cheap on 32-bit cores.
+//   - Q16 keeps every product inside 32 bits (operands are halved before
+//     multiplying), so 8-bit AVR cores never touch 64-bit or float math.
+//     Components must stay below 1.41 and magnitudes below 2.0, which holds for
+//     unit quaternions and for the gravity and direction vectors derived from
+//     them.
+// HELPER_3DMATH_FIXED_FRAC picks the format behind the QuaternionFix and
+// VectorFix typedefs at compile time (Q16 on AVR, Q30 elsewhere by default).
+// ---------------------------------------------------------------------------
+
+template <typename T> inline T fixedSqrt(T n) {
+    // bitwise integer square root, floor(sqrt(n))
+    T root = 0;
+    T bit = (T)1 << (sizeof(T) * 8 - 2);
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+template <uint8_t F> struct FixedMath;
+
+template <> struct FixedMath<16> {
+    static const int32_t one = 65536L;
+
+    static int32_t mul(int32_t a, int32_t b) {
+        return ((a >> 1) * (b >> 1)) >> 14;
+    }
+
+    static uint32_t square(int32_t a) {
+        int32_t h = a >> 1;
+        return (uint32_t)(h * h); // Q30
+    }
+
+    static int32_t magnitude(int32_t a, int32_t b, int32_t c, int32_t d=0) {
+        return (int32_t)fixedSqrt(square(a) + square(b) + square(c) + square(d)) << 1;
+    }
+
+    // 1/magnitude from one Newton step around 1.0, when the magnitude is within 1/16 of unit
+    static bool nearUnitScale(int32_t a, int32_t b, int32_t c, int32_t d, int32_t *k) {
+        int32_t e = (int32_t)((1UL << 30) - (square(a) + square(b) + square(c) + square(d))) >> 14;
+        if (e <= -one / 16 || e >= one / 16) return false;
+        *k = one + e / 2;
+        return true;
+    }
+
+    // a / m for |a| <= m, Q16
+    static int32_t div(int32_t a, int32_t m) {
+        if (!m) return 0;
+        uint32_t ua = (uint32_t)(a < 0 ? -a : a) << 15;
+        int32_t r = (int32_t)(ua / (uint32_t)(m >> 1));
+        return a < 0 ? -r : r;
+    }
+};
+
+template <> struct FixedMath<30> {
+    static const int32_t one = 1073741824L;
+
+    static int32_t mul(int32_t a, int32_t b) {
+        return (int32_t)(((int64_t)a * b) >> 30);
+    }
+
+    static uint64_t square(int32_t a) {
+        return (uint64_t)((int64_t)a * a); // Q60
+    }
+
+    static int32_t magnitude(int32_t a, int32_t b, int32_t c, int32_t d=0) {
+        return (int32_t)fixedSqrt(square(a) + square(b) + square(c) + square(d));
+    }
+
+    static bool nearUnitScale(int32_t a, int32_t b, int32_t c, int32_t d, int32_t *k) {
+        int64_t e = (int64_t)((1ULL << 60) - (square(a) + square(b) + square(c) + square(d))) >> 30;
+        if (e <= -one / 16 || e >= one / 16) return false;
+        *k = one + (int32_t)e / 2;
+        return true;
+    }
+
+    static int32_t div(int32_t a, int32_t m) {
+        if (!m) return 0;
+        return (int32_t)((int64_t)a * one / m);
+    }
+};
+
+template <uint8_t F> class QuaternionFixed {
+    public:
+        int32_t w;
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        QuaternionFixed() {
+            w = FixedMath<F>::one;
+            x = 0;
+            y = 0;
+            z = 0;
+        }
+
+        QuaternionFixed(int32_t nw, int32_t nx, int32_t ny, int32_t nz) {
+            w = nw;
+            x = nx;
+            y = ny;
+            z = nz;
+        }
+
+        // from the DMP's Q30 quaternion, as filled by dmpGetQuaternion(int32_t *)
+        QuaternionFixed(const int32_t *dmp) {
+            w = dmp[0] >> (30 - F);
+            x = dmp[1] >> (30 - F);
+            y = dmp[2] >> (30 - F);
+            z = dmp[3] >> (30 - F);
+        }
+
+        QuaternionFixed getProduct(const QuaternionFixed &q) const {
+            // same expansion as Quaternion::getProduct()
+            return QuaternionFixed(
+                FixedMath<F>::mul(w, q.w) - FixedMath<F>::mul(x, q.x) - FixedMath<F>::mul(y, q.y) - FixedMath<F>::mul(z, q.z),
+                FixedMath<F>::mul(w, q.x) + FixedMath<F>::mul(x, q.w) + FixedMath<F>::mul(y, q.z) - FixedMath<F>::mul(z, q.y),
+                FixedMath<F>::mul(w, q.y) - FixedMath<F>::mul(x, q.z) + FixedMath<F>::mul(y, q.w) + FixedMath<F>::mul(z, q.x),
+                FixedMath<F>::mul(w, q.z) + FixedMath<F>::mul(x, q.y) - FixedMath<F>::mul(y, q.x) + FixedMath<F>::mul(z, q.w));
+        }
+
+        QuaternionFixed getConjugate() const {
+            return QuaternionFixed(w, -x, -y, -z);
+        }
+
+        int32_t getMagnitude() const {
+            return FixedMath<F>::magnitude(w, x, y, z);
+        }
+
+        void normalize() {
+            int32_t k;
+            if (FixedMath<F>::nearUnitScale(w, x, y, z, &k)) {
+                // DMP output is already close to unit length, skip the square root and divisions
+                w = FixedMath<F>::mul(w, k);
+                x = FixedMath<F>::mul(x, k);
+                y = FixedMath<F>::mul(y, k);
+                z = FixedMath<F>::mul(z, k);
+                return;
+            }
+            int32_t m = getMagnitude();
+            w = FixedMath<F>::div(w, m);
+            x = FixedMath<F>::div(x, m);
+            y = FixedMath<F>::div(y, m);
+            z = FixedMath<F>::div(z, m);
+        }
+
+        QuaternionFixed getNormalized() const {
+            QuaternionFixed r(w, x, y, z);
+            r.normalize();
+            return r;
+        }
+
+        Quaternion toFloat() const {
+            const float scale = 1.0f / FixedMath<F>::one;
+            return Quaternion(w * scale, x * scale, y * scale, z * scale);
+        }
+};
+
+template <uint8_t F> class VectorFixed {
+    public:
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        VectorFixed() {
+            x = 0;
+            y = 0;
+            z = 0;
+        }
+
+        VectorFixed(int32_t nx, int32_t ny, int32_t nz) {
+            x = nx;
+            y = ny;
+            z = nz;
+        }
+
+        int32_t getMagnitude() const {
+            return FixedMath<F>::magnitude(x, y, z);
+        }
+
+        void normalize() {
+            int32_t k;
+            if (FixedMath<F>::nearUnitScale(x, y, z, 0, &k)) {
+                x = FixedMath<F>::mul(x, k);
+                y = FixedMath<F>::mul(y, k);
+                z = FixedMath<F>::mul(z, k);
+                return;
+            }
+            int32_t m = getMagnitude();
+            x = FixedMath<F>::div(x, m);
+            y = FixedMath<F>::div(y, m);
+            z = FixedMath<F>::div(z, m);
+        }
+
+        VectorFixed getNormalized() const {
+            VectorFixed r(x, y, z);
+            r.normalize();
+            return r;
+        }
+
+        void rotate(const QuaternionFixed<F> *q) {
+            // P_out = q * P_in * conj(q), as VectorFloat::rotate()
+            QuaternionFixed<F> p(0, x, y, z);
+            p = q -> getProduct(p);
+            p = p.getProduct(q -> getConjugate());
+            x = p.x;
+            y = p.y;
+            z = p.z;
+        }
+
+        VectorFixed getRotated(const QuaternionFixed<F> *q) const {
+            VectorFixed r(x, y, z);
+            r.rotate(q);
+            return r;
+        }
+
+        // gravity direction for orientation q, as dmpGetGravity(VectorFloat *, Quaternion *)
+        static VectorFixed getGravity(const QuaternionFixed<F> *q) {
+            return VectorFixed(
+                2 * (FixedMath<F>::mul(q -> x, q -> z) - FixedMath<F>::mul(q -> w, q -> y)),
+                2 * (FixedMath<F>::mul(q -> w, q -> x) + FixedMath<F>::mul(q -> y, q -> z)),
+                FixedMath<F>::mul(q -> w, q -> w) - FixedMath<F>::mul(q -> x, q -> x)
+                    - FixedMath<F>::mul(q -> y, q -> y) + FixedMath<F>::mul(q -> z, q -> z));
+        }
+
+        VectorFloat toFloat() const {
+            const float scale = 1.0f / FixedMath<F>::one;
+            return VectorFloat(x * scale, y * scale, z * scale);
+        }
+};
+
+#ifndef HELPER_3DMATH_FIXED_FRAC
+    #ifdef __AVR__
+        #define HELPER_3DMATH_FIXED_FRAC 16
+    #else
+        #define HELPER_3DMATH_FIXED_FRAC 30
+    #endif
+#endif
+
+typedef QuaternionFixed<HELPER_3DMATH_FIXED_FRAC> QuaternionFix;
+typedef VectorFixed<HELPER_3DMATH_FIXED_FRAC> VectorFix;
+
 #endif /* _HELPER_3DMATH_H_ */
\ No newline at end of file
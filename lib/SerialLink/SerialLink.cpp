@@ -0,0 +1,159 @@
+// SerialLink - framed binary messages on the UART between the ESP8266 bridge and the Uno
+
+#include "SerialLink.h"
+
+/** CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise: frames are at most 18 bytes. */
+uint16_t serialLinkCrc(const uint8_t *data, uint8_t length) {
+    uint16_t crc = 0xFFFF;
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+SerialLink::SerialLink(HardwareSerial &port) {
+    this->port = &port;
+    handler = 0;
+    memset(slots, 0, sizeof(slots));
+    memset(rxSeq, 0, sizeof(rxSeq));
+    rxSeen = 0;
+    rxLength = 0;
+    rxOverrun = false;
+    framesSent = framesReceived = framesReplaced = framesLost = 0;
+    crcErrors = framingErrors = 0;
+}
+
+/** Start the link. The port must already be open.
+ * A lone delimiter ends whatever the peer has buffered (boot messages, a
+ * frame cut by a reset), so the first real frame is received intact.
+ */
+void SerialLink::begin(Handler handler) {
+    this->handler = handler;
+    port->write((uint8_t)0);
+}
+
+/** Queue a message, replacing one of the same type that has not gone out yet.
+ * @return false for an unknown type or an oversized payload
+ */
+bool SerialLink::send(uint8_t type, const void *payload, uint8_t length) {
+    if (!type || type >= SERIALLINK_TYPES || length > SERIALLINK_PAYLOAD_MAX) return false;
+    Slot &slot = slots[type];
+    if (slot.pending) framesReplaced++;
+    memcpy(slot.payload, payload, length);
+    slot.length = length;
+    slot.pending = true;
+    return true;
+}
+
+bool SerialLink::pending(uint8_t type) const {
+    return type < SERIALLINK_TYPES && slots[type].pending;
+}
+
+/** seq of the last frame of this type written to the port. */
+uint8_t SerialLink::sentSeq(uint8_t type) const {
+    return type < SERIALLINK_TYPES ? slots[type].seq : 0;
+}
+
+/** Receive and dispatch whatever the UART holds, then write pending frames
+ * in priority order for as long as they fit in the TX buffer. Never blocks.
+ */
+void SerialLink::poll() {
+    receive();
+    for (uint8_t type = 1; type < SERIALLINK_TYPES; type++) {
+        if (slots[type].pending && !transmit(type)) break;
+    }
+}
+
+/** COBS-encode one pending frame straight into the port.
+ * @return false when the TX buffer has no room for it yet
+ */
+bool SerialLink::transmit(uint8_t type) {
+    Slot &slot = slots[type];
+    uint8_t length = slot.length + 4;
+    if (port->availableForWrite() < length + 2) return false;
+
+    uint8_t frame[SERIALLINK_FRAME_MAX];
+    frame[0] = type;
+    frame[1] = slot.seq + 1;
+    memcpy(frame + 2, slot.payload, slot.length);
+    uint16_t crc = serialLinkCrc(frame, slot.length + 2);
+    frame[length - 2] = crc & 0xFF;
+    frame[length - 1] = crc >> 8;
+
+    // frames are shorter than 254 bytes, so each zero (and the end) closes one block
+    uint8_t encoded[SERIALLINK_ENCODED_MAX];
+    uint8_t code = 0, out = 1;
+    for (uint8_t i = 0; i < length; i++) {
+        if (frame[i]) {
+            encoded[out++] = frame[i];
+        } else {
+            encoded[code] = out - code;
+            code = out++;
+        }
+    }
+    encoded[code] = out - code;
+    encoded[out++] = 0;
+    port->write(encoded, out);
+
+    slot.seq++;
+    slot.pending = false;
+    framesSent++;
+    return true;
+}
+
+void SerialLink::receive() {
+    int available = port->available();
+    while (available-- > 0) {
+        uint8_t c = port->read();
+        if (c) {
+            if (rxLength < sizeof(rx)) rx[rxLength++] = c;
+            else rxOverrun = true;
+            continue;
+        }
+
+        // delimiter: decode the COBS blocks in place
+        uint8_t encodedLength = rxLength;
+        rxLength = 0;
+        if (!encodedLength) continue;
+        if (rxOverrun) {
+            rxOverrun = false;
+            framingErrors++;
+            continue;
+        }
+        uint8_t length = 0, i = 0;
+        bool valid = true;
+        while (i < encodedLength) {
+            uint8_t code = rx[i++];
+            if (i + code - 1 > encodedLength) {
+                valid = false;
+                break;
+            }
+            for (uint8_t j = 1; j < code; j++) rx[length++] = rx[i++];
+            if (code < 0xFF && i < encodedLength) rx[length++] = 0;
+        }
+        if (!valid || length < 4) {
+            framingErrors++;
+            continue;
+        }
+
+        uint16_t crc = rx[length - 2] | (uint16_t)rx[length - 1] << 8;
+        if (crc != serialLinkCrc(rx, length - 2)) {
+            crcErrors++;
+            continue;
+        }
+        uint8_t type = rx[0], seq = rx[1];
+        if (!type || type >= SERIALLINK_TYPES) {
+            framingErrors++;
+            continue;
+        }
+        uint8_t gap = seq - rxSeq[type];
+        if ((rxSeen & (1 << type)) && gap < 0x80) framesLost += gap; // a jump back is the peer restarting
+        rxSeen |= 1 << type;
+        rxSeq[type] = seq + 1;
+        framesReceived++;
+        if (handler) handler(type, seq, rx + 2, length - 4);
+    }
+}
@@ -0,0 +1,121 @@
+// SerialLink - framed binary messages on the UART between the ESP8266 bridge and the Uno
+//
+// Frame on the wire:
+//   COBS( type | seq | payload (0..16 bytes) | CRC-16/CCITT-FALSE, little-endian ) 0x00
+//
+// COBS removes every 0x00 from the frame, so 0x00 only ever marks a frame end
+// and the receiver resynchronises on the next one after noise or a dropped
+// byte. The CRC covers type, seq and payload. seq counts per message type, so
+// the receiver sees lost frames as gaps.
+//
+// Each message type has one pending slot. A newer setpoint or pose replaces
+// one that has not gone out yet; there is no point sending stale state.
+// poll() writes a frame only when it fits in the UART's TX buffer, and it
+// writes the highest-priority pending type first (ack, setpoint, trace,
+// sensors, pose, task statistics). So a command never waits behind queued telemetry,
+// and sending never blocks the loop. Senders do not wait for acks: an ack names the newest
+// frame of a type the peer has received, and the sender decides whether to
+// resend.
+
+#ifndef _SERIALLINK_H_
+#define _SERIALLINK_H_
+
+#include <Arduino.h>
+
+#define SERIALLINK_PAYLOAD_MAX      16
+#define SERIALLINK_FRAME_MAX        (2 + SERIALLINK_PAYLOAD_MAX + 2)    // type, seq, payload, CRC
+#define SERIALLINK_ENCODED_MAX      (SERIALLINK_FRAME_MAX + 2)          // COBS overhead and delimiter
+
+// message types, in priority order
+#define SERIALLINK_ACK          1   // SerialLinkAck, both directions
+#define SERIALLINK_SETPOINT     2   // SerialLinkSetpoint, ESP -> Uno
+#define SERIALLINK_TRACE        3   // SerialLinkTrace, Uno -> ESP
+#define SERIALLINK_SENSORS      4   // SerialLinkSensors, Uno -> ESP
+#define SERIALLINK_POSE         5   // SerialLinkPose, Uno -> ESP
+#define SERIALLINK_TASK         6   // SerialLinkTask, Uno -> ESP
+#define SERIALLINK_TYPES        7
+
+#define SERIALLINK_SENSOR_MINE  0x01    // SerialLinkSensors::flags
+
+struct __attribute__((packed)) SerialLinkAck {
+    uint8_t type;           // message type acknowledged
+    uint8_t seq;            // newest seq of that type received
+};
+
+struct __attribute__((packed)) SerialLinkSetpoint {
+    int16_t linear;         // mm/s, forward positive
+    int16_t angular;        // mrad/s, counter-clockwise positive
+};
+
+// sent once a setpoint has reached the motors, for latency tracing
+struct __attribute__((packed)) SerialLinkTrace {
+    uint8_t seq;            // of the setpoint frame
+    uint16_t latency;       // us from receiving the setpoint to writing the motor PWM
+};
+
+struct __attribute__((packed)) SerialLinkSensors {
+    uint16_t range[3];      // mm, front, left, right; 0 = no echo
+    uint8_t flags;          // SERIALLINK_SENSOR_*
+};
+
+struct __attribute__((packed)) SerialLinkPose {
+    uint32_t time;          // millis() on the Uno
+    int32_t x;              // mm
+    int32_t y;              // mm
+    int16_t heading;        // mrad, counter-clockwise from +x
+};
+
+struct __attribute__((packed)) SerialLinkTask {
+    char name[4];           // not NUL-terminated when 4 characters long
+    uint8_t id;             // index in the Uno's task table
+    uint8_t count;          // tasks in the table
+    uint16_t wcet;          // us, longest run so far
+    uint16_t overruns;      // runs that finished past their deadline
+    uint16_t skipped;       // releases missed entirely
+    uint32_t runs;
+};
+
+class SerialLink {
+    public:
+        typedef void (*Handler)(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t length);
+
+        SerialLink(HardwareSerial &port);
+
+        void begin(Handler handler);
+        void poll();
+
+        bool send(uint8_t type, const void *payload, uint8_t length);
+        bool pending(uint8_t type) const;
+        uint8_t sentSeq(uint8_t type) const;
+
+        uint32_t framesSent;
+        uint32_t framesReceived;    // passed the CRC and were dispatched
+        uint32_t framesReplaced;    // pending frames replaced by a newer one before going out
+        uint32_t framesLost;        // seq gaps on receive
+        uint32_t crcErrors;
+        uint32_t framingErrors;     // overlong, short or malformed COBS
+
+    private:
+        bool transmit(uint8_t type);
+        void receive();
+
+        HardwareSerial *port;
+        Handler handler;
+
+        struct Slot {
+            bool pending;
+            uint8_t seq;            // of the last frame sent
+            uint8_t length;
+            uint8_t payload[SERIALLINK_PAYLOAD_MAX];
+        } slots[SERIALLINK_TYPES];
+
+        uint8_t rxSeq[SERIALLINK_TYPES];    // next seq expected per type
+        uint8_t rxSeen;                     // bit per type: rxSeq is valid
+        uint8_t rx[SERIALLINK_ENCODED_MAX];
+        uint8_t rxLength;
+        bool rxOverrun;                     // frame too long, skip to the next delimiter
+};
+
+uint16_t serialLinkCrc(const uint8_t *data, uint8_t length);
+
+#endif /* _SERIALLINK_H_ */
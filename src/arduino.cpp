@@ -3,83 +3,318 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <I2Cdev.h>
-#include <MPU6050.h>
+#include <MPU6050_6Axis_MotionApps20.h>
+#include <MPU6050_FIFOReader.h>
+#include <SerialLink.h>
+#include "task_scheduler.h"
+
+#define MPU_INT_PIN 2
+#define MINE_PIN    3       // цифровий вихід металошукача: HIGH - під датчиком метал
+
+#define ODOMETRY_PERIOD_US  10000   // 100 Hz
+#define POSE_PERIOD_US      20000   // кадр пози для ESP: 50 Гц
+#define SETPOINT_TIMEOUT_MS 500     // без нових уставок довше за це - зупинка
+#define IMU_STALE_US        100000  // старіший за це курс DMP не використовується
+
+#define WHEEL_BASE_MM       140     // відстань між центрами коліс
+#define WHEEL_SPEED_MAX     1000    // мм/с колеса при ШІМ 255
+#define DRIVE_PWM_MIN       60      // нижче цього ШІМ мотори не рушають з місця
+#define LINEAR_ACCEL_MAX    2000    // мм/с^2
+#define ANGULAR_ACCEL_MAX   12000   // мрад/с^2
+
+#define RANGE_SENSORS       3       // спереду, зліва, справа
+#define RANGE_SLOT_US       30000   // кожен датчик має своє вікно: відлуння одного не потрапляє в інший
+#define RANGE_TIMEOUT_US    25000   // ~4 м: довше відлуння вважаємо відсутнім
+#define RANGE_TRIGGER_US    10      // тривалість імпульсу запуску HC-SR04
+#define RANGE_MEDIAN        5       // вимірів у медіанному фільтрі
+#define RANGE_NONE          0xFFFF  // немає відлуння (у фільтрі - "дуже далеко")
 
 class Coordinates {
   private:
     float x;
     float y;
     float angle;
-    char lastMove;
-    unsigned long lastTime;
-    float velocity; 
-    float angle_velocity;
+    unsigned long lastTime;   // micros()
+    float velocity;           // м/с
+    float angle_velocity;     // рад/с, проти годинникової стрілки
+    bool headingSet;          // курс на цьому кроці задано ззовні (DMP)
 
   public:
     Coordinates() {
       x = 0.0;
       y = 0.0;
       angle = 0.0;
-      lastMove = 's'; // 's' for stop, або інше значення за замовчуванням
-      lastTime = millis();
-      velocity = 1.0; // Початкова швидкість 0
-      angle_velocity = 1.0; // Початкова кутова швидкість 0
+      lastTime = micros();
+      headingSet = false;
+      velocity = 0.0; // Початкова швидкість 0
+      angle_velocity = 0.0; // Початкова кутова швидкість 0
     }
     
-    void setLastMove(char newMove) {
-      lastMove = newMove;
+    // Швидкості, з якими робот рухатиметься до наступного кроку
+    void setVelocity(float linear, float angular) {
+      velocity = linear;
+      angle_velocity = angular;
     }
 
+    // Курс з DMP замість інтегрування команди повороту на наступному кроці
+    void setHeading(float heading) {
+      angle = heading;
+      headingSet = true;
+    }
+
+    float getX() { return x; }
+    float getY() { return y; }
+    float getAngle() { return angle; }
+
     void updateCoordinates() {
-      float currentTime = millis();
-      float delta_t = (currentTime - lastTime) / 1000.0;
+      unsigned long currentTime = micros();
+      float delta_t = (currentTime - lastTime) / 1000000.0;
       lastTime = currentTime;
+      bool integrateTurn = !headingSet;
+      headingSet = false;
 
-      if (lastMove == 'f') {
-        float delta = velocity * delta_t;
-        x += delta * cos(angle);
-        y += delta * sin(angle);
-      } else if (lastMove == 'b') {
-        float delta = velocity * delta_t;
-        x -= delta * cos(angle);
-        y -= delta * sin(angle);
-      } else if (lastMove == 'r') {
-        angle -= angle_velocity * delta_t;
-      } else if (lastMove == 'l') {
+      float delta = velocity * delta_t;
+      x += delta * cos(angle);
+      y += delta * sin(angle);
+      if (integrateTurn) {
         angle += angle_velocity * delta_t;
       }
+      if (angle > PI) angle -= TWO_PI;
+      if (angle <= -PI) angle += TWO_PI;
     }
 };
 
+// Ультразвуковий датчик без блокування: запуск і очікування відлуння веде
+// Ranging, фронти відлуння мітить переривання зміни стану піна
 class UltraSonic {
   private:
-    int trigPin;
-    int echoPin;
+    uint8_t trigPin;
+    uint8_t echoPin;
+    uint16_t history[RANGE_MEDIAN];   // мм, останні виміри
+    uint8_t historyHead;
+    uint16_t latest;
+    uint16_t filtered;
 
   public:
-    UltraSonic(int trig, int echo) {
+    // заповнює ISR, поки датчик активний
+    volatile unsigned long echoRise;
+    volatile unsigned long echoWidth;
+    volatile bool echoDone;
+
+    UltraSonic(uint8_t trig, uint8_t echo) {
       trigPin = trig;
       echoPin = echo;
+      historyHead = 0;
+      latest = filtered = RANGE_NONE;
+      for (uint8_t i = 0; i < RANGE_MEDIAN; i++) history[i] = RANGE_NONE;
+    }
+
+    void begin() {
       pinMode(trigPin, OUTPUT);
+      digitalWrite(trigPin, LOW);
       pinMode(echoPin, INPUT);
     }
 
-    // Метод вимірювання відстані в сантиметрах
-    float getDistance() {
-      digitalWrite(trigPin, LOW);
-      delayMicroseconds(2);
-      digitalWrite(trigPin, HIGH);
-      delayMicroseconds(10);
-      digitalWrite(trigPin, LOW);
+    uint8_t getTrigPin() { return trigPin; }
+    uint8_t getEchoPin() { return echoPin; }
 
-      unsigned long duration = pulseIn(echoPin, HIGH, 8746);
+    // Фронт на echoPin: початок імпульсу запам'ятовуємо, кінець дає тривалість
+    void onEdge() {
+      unsigned long now = micros();
+      if (digitalRead(echoPin)) {
+        echoRise = now;
+      } else if (echoRise) {
+        echoWidth = now - echoRise;
+        echoDone = true;
+      }
+    }
 
-      float distance = (duration * 0.0343) / 2.0;
+    // Результат виміру (мкс відлуння, 0 - немає) -> мм, і медіана останніх вимірів
+    void publish(unsigned long width) {
+      latest = width ? (uint16_t)(width * 343UL / 2000) : RANGE_NONE;
+      history[historyHead] = latest;
+      historyHead = (historyHead + 1) % RANGE_MEDIAN;
 
-      return (distance > 0.0) ? distance : 100.0;
+      uint16_t sorted[RANGE_MEDIAN];
+      for (uint8_t i = 0; i < RANGE_MEDIAN; i++) {
+        uint16_t value = history[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > value; j--) sorted[j] = sorted[j - 1];
+        sorted[j] = value;
+      }
+      filtered = sorted[RANGE_MEDIAN / 2];
     }
+
+    // Відстань у мм; RANGE_NONE, якщо відлуння немає
+    uint16_t getDistance() { return latest; }
+    uint16_t getFiltered() { return filtered; }
 };
 
+// Опитування датчиків по черзі: кожен запускається на початку свого вікна
+// RANGE_SLOT_US і чекає відлуння не довше RANGE_TIMEOUT_US. update() нічого
+// не чекає: кожен виклик лише переводить автомат на наступний крок
+class Ranging {
+  private:
+    enum State { IDLE, TRIGGER, ECHO };
+
+    UltraSonic **sensors;
+    uint8_t count;
+    uint8_t current;
+    State state;
+    unsigned long slotStart;
+    unsigned long triggeredAt;
+
+    static Ranging *active;
+
+  public:
+    uint32_t readings;       // вимірів усього
+    uint32_t timeouts;       // з них без відлуння
+
+    Ranging(UltraSonic **sensorList, uint8_t sensorCount) {
+      sensors = sensorList;
+      count = sensorCount;
+      current = 0;
+      state = IDLE;
+      slotStart = triggeredAt = 0;
+      readings = timeouts = 0;
+    }
+
+    void begin();
+
+    // Спільний обробник переривань echo-пінів: слухає лише активний датчик
+    static void isr() {
+      if (active && active->state == ECHO) active->sensors[active->current]->onEdge();
+    }
+
+    // true, коли з'явився новий вимір (датчик current)
+    bool update() {
+      unsigned long now = micros();
+      UltraSonic *sensor = sensors[current];
+
+      if (state == IDLE) {
+        if (now - slotStart < RANGE_SLOT_US) return false;
+        slotStart = now;
+        sensor->echoRise = 0;
+        sensor->echoDone = false;
+        digitalWrite(sensor->getTrigPin(), HIGH);
+        triggeredAt = now;
+        state = TRIGGER;
+        return false;
+      }
+
+      if (state == TRIGGER) {
+        if (now - triggeredAt < RANGE_TRIGGER_US) return false;
+        digitalWrite(sensor->getTrigPin(), LOW);
+        triggeredAt = now;
+        state = ECHO;
+        return false;
+      }
+
+      unsigned long width = 0;
+      if (sensor->echoDone) {
+        noInterrupts();
+        width = sensor->echoWidth;
+        interrupts();
+        if (width > RANGE_TIMEOUT_US) width = 0;
+      } else if (now - triggeredAt < RANGE_TIMEOUT_US) {
+        return false;
+      }
+      if (!width) timeouts++;
+      readings++;
+      sensor->publish(width);
+      state = IDLE;
+      current = (current + 1) % count;
+      return true;
+    }
+};
+
+Ranging *Ranging::active = 0;
+
+#if defined(__AVR__)
+// echo-піни на перериваннях зміни стану піна: підходить будь-який пін
+ISR(PCINT0_vect) { Ranging::isr(); }
+ISR(PCINT1_vect) { Ranging::isr(); }
+ISR(PCINT2_vect) { Ranging::isr(); }
+#endif
+
+void Ranging::begin() {
+  active = this;
+  for (uint8_t i = 0; i < count; i++) {
+    sensors[i]->begin();
+    uint8_t echo = sensors[i]->getEchoPin();
+#if defined(__AVR__)
+    *digitalPinToPCMSK(echo) |= bit(digitalPinToPCMSKbit(echo));
+    *digitalPinToPCICR(echo) |= bit(digitalPinToPCICRbit(echo));
+#else
+    attachInterrupt(digitalPinToInterrupt(echo), isr, CHANGE);
+#endif
+  }
+  slotStart = micros() - RANGE_SLOT_US;
+}
+
+// Диференціальний привід: уставки лінійної (м/с) і кутової (рад/с) швидкості
+// з обмеженням прискорення перетворюються на швидкості та ШІМ коліс
+class DiffDrive {
+  private:
+    float targetLinear;
+    float targetAngular;
+    float linear;             // після обмеження прискорення
+    float angular;
+    float leftSpeed;          // м/с, після обмеження швидкості колеса
+    float rightSpeed;
+
+    static int toPwm(float speed) {
+      if (speed == 0.0) return 0;
+      int pwm = DRIVE_PWM_MIN + (255 - DRIVE_PWM_MIN) * fabs(speed) * 1000.0 / WHEEL_SPEED_MAX;
+      pwm = constrain(pwm, DRIVE_PWM_MIN, 255);
+      return speed > 0 ? pwm : -pwm;
+    }
+
+  public:
+    DiffDrive() {
+      targetLinear = targetAngular = 0.0;
+      linear = angular = 0.0;
+      leftSpeed = rightSpeed = 0.0;
+    }
+
+    void setTarget(float linearTarget, float angularTarget) {
+      targetLinear = linearTarget;
+      targetAngular = angularTarget;
+    }
+
+    // Крок керування: наближаємо обидві швидкості до уставок однією часткою
+    // кроку, обмеженою допустимими прискореннями (тож при розгоні й гальмуванні
+    // на дузі кривизна не змінюється); якщо колесо впирається в максимум, обидва
+    // колеса сповільнюються пропорційно
+    void update(float dt) {
+      float dLinear = targetLinear - linear;
+      float dAngular = targetAngular - angular;
+      float fraction = 1.0;
+      float linearStep = LINEAR_ACCEL_MAX / 1000.0 * dt;
+      float angularStep = ANGULAR_ACCEL_MAX / 1000.0 * dt;
+      if (fabs(dLinear) > linearStep) fraction = linearStep / fabs(dLinear);
+      if (fabs(dAngular) * fraction > angularStep) fraction = angularStep / fabs(dAngular);
+      linear += dLinear * fraction;
+      angular += dAngular * fraction;
+
+      float half = angular * WHEEL_BASE_MM / 2000.0;
+      leftSpeed = linear - half;
+      rightSpeed = linear + half;
+      float peak = max(fabs(leftSpeed), fabs(rightSpeed));
+      float limit = WHEEL_SPEED_MAX / 1000.0;
+      if (peak > limit) {
+        leftSpeed *= limit / peak;
+        rightSpeed *= limit / peak;
+      }
+    }
+
+    // Фактичні швидкості після обмежень, для одометрії
+    float getLinear() { return (leftSpeed + rightSpeed) / 2.0; }
+    float getAngular() { return (rightSpeed - leftSpeed) * 1000.0 / WHEEL_BASE_MM; }
+
+    int getLeftPwm() { return toPwm(leftSpeed); }
+    int getRightPwm() { return toPwm(rightSpeed); }
+};
 
 class Motor {
   private:
@@ -110,6 +345,13 @@ class Motor {
           digitalWrite(frontPin, LOW);
           digitalWrite(backPin, HIGH);
       }
+
+      // Знак ШІМ задає напрямок
+      void drive(int pwm) {
+          if (pwm > 0) forward(pwm);
+          else if (pwm < 0) backward(-pwm);
+          else stop();
+      }
   };
 
   class Robot {
@@ -119,35 +361,19 @@ class Motor {
         Coordinates coordinates;
     public:
         Robot(Motor leftM, Motor rightM, Coordinates currentCoordinates): leftMotor{leftM}, rightMotor{rightM}, coordinates{currentCoordinates}{ };
+
+        Coordinates &getCoordinates() {
+            return coordinates;
+        }
     
-        void moveForward(int speed, float left, float right) {
-            leftMotor.forward(speed * left);
-            rightMotor.forward(speed * right);
-            coordinates.setLastMove('f');
+        void drive(int leftPwm, int rightPwm) {
+            leftMotor.drive(leftPwm);
+            rightMotor.drive(rightPwm);
         }
     
         void stopMotors() {
             leftMotor.stop();
             rightMotor.stop();
-            coordinates.setLastMove('s');
-        }
-    
-        void rotateClockwise(int speed) {
-            leftMotor.forward(speed);  // Лівий мотор рухається вперед
-            rightMotor.backward(speed);    // Правий мотор рухається назад
-            coordinates.setLastMove('r');
-        }
-    
-        void rotateCounterClockwise(int speed) {
-            leftMotor.backward(speed);     // Лівий мотор рухається назад
-            rightMotor.forward(speed); // Правий мотор рухається вперед
-            coordinates.setLastMove('l');
-        }
-    
-        void moveBackward(int speed, float left, float right) {
-            leftMotor.backward(speed * left);  // Лівий мотор рухається назад з урахуванням коефіцієнта
-            rightMotor.backward(speed * right); // Правий мотор рухається назад з урахуванням коефіцієнта
-            coordinates.setLastMove('b');
         }
     };
 
@@ -155,33 +381,189 @@ Motor lMotor(5, 9, 10);
 Motor rMotor(6, 12, 11);
 Coordinates currentCoordinates;
 Robot robot(lMotor, rMotor, currentCoordinates);
+DiffDrive drive;
+
+UltraSonic frontSonic(4, A0);
+UltraSonic leftSonic(7, A1);
+UltraSonic rightSonic(8, A2);
+UltraSonic *sonics[RANGE_SENSORS] = { &frontSonic, &leftSonic, &rightSonic };
+Ranging ranging(sonics, RANGE_SENSORS);
+
+MPU6050 mpu;
+// Розмір пакета задає прошивка DMP, а не значення за замовчуванням читача
+static_assert(MPU6050::PACKET_SIZE <= MPU6050_FIFOREADER_PACKET_SIZE, "пакет DMP не вміщується в буфер MPU6050_FIFOReader");
+MPU6050_FIFOReader imuReader(mpu, MPU6050::PACKET_SIZE);
+bool imuReady = false;
+float imuYaw = 0.0;           // DMP yaw, rad
+float imuYawZero = 0.0;       // DMP yaw at the first packet: the robot's starting heading
+bool imuHasYaw = false;
+unsigned long imuStamp = 0;   // micros() of the packet imuYaw came from
+
+SerialLink link(Serial);
+
+unsigned long lastOdometry = 0;
+unsigned long setpointAt = 0; // millis() останньої уставки
+
+// Трасування затримки: уставка, що ще не дійшла до двигунів
+bool tracePending = false;
+uint8_t traceSeq = 0;
+unsigned long traceAt = 0;    // micros() прийому уставки
+
+// Забирає пакети DMP без очікування: кожен виклик робить не більше однієї I2C транзакції
+void updateHeading() {
+  imuReader.poll();
+  while (imuReader.available() > 1) imuReader.discard(); // потрібен лише найсвіжіший пакет
+
+  MPU6050_FIFOPacket packet;
+  if (imuReader.read(&packet)) {
+    // лише курс: без гравітації, тангажу і крену (два atan2 і sqrt на кожен пакет)
+    MPU6050::Packet view(packet.data);
+    imuYaw = view.yaw();
+    imuStamp = packet.timestamp;
+    if (!imuHasYaw) {
+      imuYawZero = imuYaw;
+      imuHasYaw = true;
+    }
+  }
+}
+
+// Кадр пози для ESP; ще не відправлений кадр замінюється новішим
+void sendPose() {
+  Coordinates &pose = robot.getCoordinates();
+  SerialLinkPose frame;
+  frame.time = millis();
+  frame.x = (int32_t)(pose.getX() * 1000);
+  frame.y = (int32_t)(pose.getY() * 1000);
+  frame.heading = (int16_t)(pose.getAngle() * 1000);
+  link.send(SERIALLINK_POSE, &frame, sizeof(frame));
+}
+
+// Відфільтровані відстані і стан металошукача для ESP після кожного нового виміру
+void sendSensors() {
+  SerialLinkSensors frame;
+  for (uint8_t i = 0; i < RANGE_SENSORS; i++) {
+    uint16_t range = sonics[i]->getFiltered();
+    frame.range[i] = range == RANGE_NONE ? 0 : range;
+  }
+  frame.flags = digitalRead(MINE_PIN) ? SERIALLINK_SENSOR_MINE : 0;
+  link.send(SERIALLINK_SENSORS, &frame, sizeof(frame));
+}
+
+// Уставка від ESP: нові цілі для приводу, підтверджуємо seq
+void handleLink(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t length) {
+  if (type != SERIALLINK_SETPOINT || length != sizeof(SerialLinkSetpoint)) return;
+  const SerialLinkSetpoint *setpoint = (const SerialLinkSetpoint *)payload;
+
+  drive.setTarget(setpoint->linear / 1000.0, setpoint->angular / 1000.0);
+  setpointAt = millis();
+  tracePending = true;
+  traceSeq = seq;
+  traceAt = micros();
+
+  SerialLinkAck ack = { SERIALLINK_SETPOINT, seq };
+  link.send(SERIALLINK_ACK, &ack, sizeof(ack));
+}
+
+// Одометрія і привід: переміщення з фактичних швидкостей приводу, курс з DMP
+// (yaw DMP росте за годинниковою стрілкою, курс робота - проти), а без
+// свіжого DMP - з інтегрованої кутової швидкості. Потім привід робить крок до
+// уставок і задає ШІМ на наступний період
+void updateOdometry() {
+  unsigned long now = micros();
+  Coordinates &pose = robot.getCoordinates();
+  if (imuHasYaw && now - imuStamp < IMU_STALE_US) {
+    float heading = imuYawZero - imuYaw;
+    if (heading > PI) heading -= TWO_PI;
+    if (heading <= -PI) heading += TWO_PI;
+    pose.setHeading(heading);
+  }
+  pose.updateCoordinates();
+
+  drive.update((now - lastOdometry) / 1000000.0);
+  lastOdometry = now;
+  robot.drive(drive.getLeftPwm(), drive.getRightPwm());
+  pose.setVelocity(drive.getLinear(), drive.getAngular());
+
+  // перший ШІМ після уставки: повідомляємо ESP, скільки вона чекала тут
+  if (tracePending) {
+    SerialLinkTrace trace = { traceSeq, (uint16_t)min(micros() - traceAt, 0xFFFFUL) };
+    link.send(SERIALLINK_TRACE, &trace, sizeof(trace));
+    tracePending = false;
+  }
+}
+
+// Задачі планувальника (task_scheduler.h)
+void linkTask() { link.poll(); }
+
+void imuTask() {
+  if (imuReady) updateHeading();
+}
+
+void rangingTask() {
+  if (ranging.update()) sendSensors();
+}
+
+// Зв'язок з ESP втрачено: зупиняємось плавно, з обмеженням прискорення
+void safetyTask() {
+  if (millis() - setpointAt > SETPOINT_TIMEOUT_MS) drive.setTarget(0.0, 0.0);
+}
+
+void statsTask();
+
+// Порядок у таблиці - пріоритет: задачі, готові в одному проході, виконуються згори вниз.
+// Випуск і лічильники нульові; startTasks() ставить перший випуск
+Task tasks[] = {
+  { "odom", updateOdometry, ODOMETRY_PERIOD_US, 2000,  0, 0, 0, 0, 0 },
+  { "link", linkTask,       1000,               1000,  0, 0, 0, 0, 0 },
+  { "imu",  imuTask,        1000,               1000,  0, 0, 0, 0, 0 },
+  { "rang", rangingTask,    1000,               1000,  0, 0, 0, 0, 0 },
+  { "pose", sendPose,       POSE_PERIOD_US,     5000,  0, 0, 0, 0, 0 },
+  { "safe", safetyTask,     50000,              10000, 0, 0, 0, 0, 0 },
+  { "stat", statsTask,      250000,             50000, 0, 0, 0, 0, 0 },
+};
+#define TASK_COUNT (sizeof(tasks) / sizeof(tasks[0]))
+
+uint8_t statsNext = 0;
+
+// Статистика однієї задачі за раз, по колу: кожна задача раз на TASK_COUNT * 250 мс
+void statsTask() {
+  Task &task = tasks[statsNext];
+  SerialLinkTask frame;
+  memset(frame.name, 0, sizeof(frame.name));
+  memcpy(frame.name, task.name, min(strlen(task.name), sizeof(frame.name)));
+  frame.id = statsNext;
+  frame.count = TASK_COUNT;
+  frame.wcet = min(task.wcet, 0xFFFFUL);
+  frame.overruns = min(task.overruns, 0xFFFFUL);
+  frame.skipped = min(task.skipped, 0xFFFFUL);
+  frame.runs = task.runs;
+  link.send(SERIALLINK_TASK, &frame, sizeof(frame));
+  statsNext = (statsNext + 1) % TASK_COUNT;
+}
 
 void setup() {
     Serial.begin(115200);
-}
 
-void loop() {
-  if (Serial.available()) {
-    char c = Serial.read();
-
-    if (c == 'f') {
-        robot.moveForward(255, 1, 1);
-        Serial.println("Moving forward");
-    } else if (c == 'b') {
-        robot.moveBackward(255, 1, 1);
-        Serial.println("Moving backward");
-    } else if (c == 'l') {
-        robot.rotateCounterClockwise(255);
-        Serial.println("Rotating counter-clockwise");
-    } else if (c == 'r') {
-        robot.rotateClockwise(255);
-        Serial.println("Rotating clockwise");
-    } else if (c == 's') {
-        robot.stopMotors();
-        Serial.println("Stopping motors");
+    Wire.begin();
+    Wire.setClock(400000);
+    mpu.initialize();
+    if (mpu.dmpInitialize() == 0) {
+        mpu.CalibrateAccel(6);
+        mpu.CalibrateGyro(6);
+        mpu.setDMPEnabled(true);
+        imuReader.begin(MPU_INT_PIN);
+        imuReady = true;
     }
-  }
+    ranging.begin();
+    pinMode(MINE_PIN, INPUT);
+    link.begin(handleLink);
+    lastOdometry = micros();
+    setpointAt = millis();
+    startTasks(tasks, TASK_COUNT);
 }
 
+void loop() {
+  runTasks(tasks, TASK_COUNT);
+}
 
 #endif
\ No newline at end of file
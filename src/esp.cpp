@@ -2,7 +2,11 @@
 
 #include <ESP8266WiFi.h>
 #include <WebSocketsServer.h>
-#include <ArduinoJson.h>  // Add this library
+
+#include <SerialLink.h>
+
+#include "telemetry.h"
+#include "frame_builder.h"
 
 // Access point credentials
 const char* ap_ssid = "ESP_Robot"; // Name of the WiFi network ESP will create
@@ -10,106 +14,701 @@ const char* ap_password = "12345678"; // Password (min 8 characters)
 
 WebSocketsServer webSocket = WebSocketsServer(81);
 
-float x = 0.0, y = 0.0;
-bool mineDetected = false;
+SerialLink link(Serial);
+
+// Pose as last reported by the Uno's odometry
+float x = 0.0, y = 0.0, heading = 0.0;
+uint32_t poseReceivedAt = 0;    // micros()
+bool poseValid = false;
+bool mineDetected = false;      // metal detector state, from the Uno's SENSORS message
+uint16_t ranges[TELEMETRY_RANGES];
+
+#define POSE_STALE_US   200000  // Uno sends 50 Hz; flag the pose stale after this long
+
+// Drive commands become setpoints; the current one is resent until the Uno acks it
+#define DRIVE_LINEAR        750     // mm/s, for the JSON direction commands
+#define DRIVE_ANGULAR       750     // mrad/s
+#define SETPOINT_RESEND_US  50000
+
+// Scheduler statistics reported by the Uno, one task per message
+#define UNO_TASKS_MAX   8
+SerialLinkTask unoTasks[UNO_TASKS_MAX];
+uint8_t unoTaskCount = 0;
+
+SerialLinkSetpoint setpoint = { 0, 0 };
+bool setpointAcked = true;
+uint32_t setpointSentAt = 0;    // micros()
+
+// Latency trace of the newest binary command, from its arrival here to the
+// Uno's report that the setpoint reached the motors
+struct CommandTrace {
+  bool active;
+  bool sent;                    // setpoint written to the UART
+  uint8_t client;
+  uint8_t id;
+  uint8_t seq;                  // of the setpoint frame on the UART
+  uint32_t origin;              // client's clock, echoed
+  uint32_t receivedAt;          // micros()
+  uint32_t sentAt;              // micros()
+};
+CommandTrace trace;
+
+#define TELEMETRY_RATE_MAX          500     // Hz, per stream
+#define TELEMETRY_BATCH_MAX         16      // frames queued per client, sent as one BIN message (512 B)
+#define TELEMETRY_LATENCY_MAX_US    50000   // oldest queued frame is flushed after this long
+#define TELEMETRY_SEND_BUDGET_US    2000    // a send blocking longer than this means the TCP buffer is full
+#define TELEMETRY_RELAX_FLUSHES     16      // fast flushes in a row before the batch shrinks again
+#define TELEMETRY_HOLD_MAX_US       500000  // longest pause between sends under backpressure
+#define TELEMETRY_JSON_MAX          160     // one JSON sample
+#define REPLY_MAX                   (64 + WEBSOCKETS_SERVER_CLIENT_MAX * 160)  // also fits UNO_TASKS_MAX * 80
+
+void fillPose(TelemetryFrame &frame);
+void fillSensors(TelemetryFrame &frame);
+void fillHealth(TelemetryFrame &frame);
+
+struct TelemetryStream {
+  const char *name;
+  uint16_t hz;              // default rate for new clients, 0 = off
+  uint32_t seq;
+  void (*fill)(TelemetryFrame &frame);
+};
+
+TelemetryStream streams[TELEMETRY_STREAMS] = {
+  { "pose",    50, 0, fillPose },
+  { "sensors", 20, 0, fillSensors },
+  { "health",   1, 0, fillHealth },
+};
+
+// Per-client telemetry: format, stream rates, a send queue and backpressure
+// state. Every client is sampled on its own schedule and flushed on its own,
+// so a slow link only ever delays its own frames. The space in front of the
+// queue lets sendBIN write the frame header in place (see frame_builder.h).
+struct TelemetryClient {
+  bool binary;                              // JSON until the client asks for binary
+  uint16_t hz[TELEMETRY_STREAMS];           // 0 = off
+  uint32_t nextDue[TELEMETRY_STREAMS];      // micros()
+  uint8_t count;                            // frames queued
+  uint8_t batchLimit;                       // frames per message; doubles under backpressure
+  uint8_t fastFlushes;
+  uint32_t oldest;                          // micros() of frames[0]
+  uint32_t holdUntil;                       // no sends before this while the link drains
+  uint32_t holdTime;                        // pause after a blocked send
+  uint32_t linkSince;                       // micros() of the last blocked send, 0 = none yet
+  uint32_t linkBytes;                       // bytes sent since then
+  uint32_t sent;                            // frames sent
+  uint32_t dropped;                         // frames dropped from a full queue, oldest first
+  uint32_t blocked;                         // us spent blocked in sends
+  struct __attribute__((packed)) {
+    uint8_t header[WEBSOCKETS_MAX_HEADER_SIZE];
+    TelemetryFrame frames[TELEMETRY_BATCH_MAX];
+  } queue;
+};
+TelemetryClient clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+uint8_t flushNext = 0;          // round-robin start for flushes
+
+// JSON messages are built once into these and sent to every client that wants them
+FrameBuilder<TELEMETRY_JSON_MAX> jsonSamples[TELEMETRY_STREAMS];
+uint32_t jsonSeq[TELEMETRY_STREAMS];        // seq of the sample in jsonSamples, + 1 (0 = none)
+FrameBuilder<REPLY_MAX> reply;
+
+uint32_t loopCount = 0, loopsPerSecond = 0, loopWindowStart = 0;
 
 // Function prototype declaration
 void webSocketEvent(uint8_t client, WStype_t type, uint8_t * payload, size_t length);
+void serviceTelemetry();
+void handleLink(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t length);
+void serviceSetpoint();
+void serviceTrace();
+void sendTrace(uint16_t unoMicros);
 
 void setup() {
   Serial.begin(115200);
   
   // Set up the ESP8266 as an access point
   WiFi.softAP(ap_ssid, ap_password);
-  
-  IPAddress myIP = WiFi.softAPIP();
-  // Serial.println("AP Mode Setup Complete");
-  // Serial.print("AP SSID: ");
-  Serial.println(ap_ssid);
-  // Serial.print("AP IP address: ");
-  Serial.println(myIP);
+  // nothing else may be printed: the UART carries only SerialLink frames to the Uno
 
   webSocket.begin();
   webSocket.onEvent(webSocketEvent);
   // Serial.println("WebSocket server started");
+
+  link.begin(handleLink);
 }
 
 void loop() {
 
   webSocket.loop();
 
-  // Simulate data
-  x += 1.0;
-  y += 0.5;
-  mineDetected = (random(0, 10) > 8);
-
-  // Send data to PC every 500 ms
-  static unsigned long lastSend = 0;
-  if (millis() - lastSend > 500) {
-    lastSend = millis();
-    
-    // Create JSON document
-    StaticJsonDocument<128> doc;
-    doc["x"] = x;
-    doc["y"] = y;
-    doc["mine"] = mineDetected ? 1 : 0;
-    
-    // Serialize JSON to string
-    String json;
-    serializeJson(doc, json);
-    
-    // Send the JSON string
-    webSocket.broadcastTXT(json);
+  link.poll();
+  serviceTrace();
+  serviceSetpoint();
+
+  serviceTelemetry();
+
+  loopCount++;
+  if (millis() - loopWindowStart >= 1000) {
+    loopWindowStart = millis();
+    loopsPerSecond = loopCount;
+    loopCount = 0;
+  }
+}
+
+void fillPose(TelemetryFrame &frame) {
+  frame.pose.x = x;
+  frame.pose.y = y;
+  frame.pose.heading = heading;
+  if (!poseValid || micros() - poseReceivedAt > POSE_STALE_US) frame.flags |= TELEMETRY_FLAG_STALE;
+  if (setpoint.linear || setpoint.angular) frame.flags |= TELEMETRY_FLAG_MOVING;
+}
+
+// Messages from the Uno. seq is not needed here: SerialLink counts gaps per type in framesLost
+void handleLink(uint8_t type, uint8_t, const uint8_t *payload, uint8_t length) {
+  if (type == SERIALLINK_POSE && length == sizeof(SerialLinkPose)) {
+    const SerialLinkPose *pose = (const SerialLinkPose *)payload;
+    x = pose->x / 1000.0;
+    y = pose->y / 1000.0;
+    heading = pose->heading / 1000.0;
+    poseReceivedAt = micros();
+    poseValid = true;
+  } else if (type == SERIALLINK_SENSORS && length == sizeof(SerialLinkSensors)) {
+    const SerialLinkSensors *sensors = (const SerialLinkSensors *)payload;
+    memcpy(ranges, sensors->range, sizeof(ranges));
+    mineDetected = sensors->flags & SERIALLINK_SENSOR_MINE;
+  } else if (type == SERIALLINK_TASK && length == sizeof(SerialLinkTask)) {
+    const SerialLinkTask *task = (const SerialLinkTask *)payload;
+    if (task->id < UNO_TASKS_MAX) {
+      unoTasks[task->id] = *task;
+      unoTaskCount = min(task->count, (uint8_t)UNO_TASKS_MAX);
+    }
+  } else if (type == SERIALLINK_TRACE && length == sizeof(SerialLinkTrace)) {
+    const SerialLinkTrace *report = (const SerialLinkTrace *)payload;
+    if (trace.active && trace.sent && report->seq == trace.seq) sendTrace(report->latency);
+  } else if (type == SERIALLINK_ACK && length == sizeof(SerialLinkAck)) {
+    const SerialLinkAck *ack = (const SerialLinkAck *)payload;
+    if (ack->type == SERIALLINK_SETPOINT && ack->seq == link.sentSeq(SERIALLINK_SETPOINT)
+        && !link.pending(SERIALLINK_SETPOINT)) {
+      setpointAcked = true;
+    }
+  }
+}
+
+void sendSetpoint(int16_t linear, int16_t angular) {
+  setpoint.linear = linear;
+  setpoint.angular = angular;
+  setpointAcked = false;
+  setpointSentAt = micros();
+  link.send(SERIALLINK_SETPOINT, &setpoint, sizeof(setpoint));
+}
+
+// Resend the current setpoint if the Uno has not acked it (frame lost or corrupted)
+void serviceSetpoint() {
+  if (setpointAcked || link.pending(SERIALLINK_SETPOINT)) return;
+  if (micros() - setpointSentAt < SETPOINT_RESEND_US) return;
+  sendSetpoint(setpoint.linear, setpoint.angular);
+}
+
+// Note when the traced setpoint left for the Uno. Called right after
+// link.poll(), so the time is good to one loop pass.
+void serviceTrace() {
+  if (!trace.active || trace.sent || link.pending(SERIALLINK_SETPOINT)) return;
+  trace.sent = true;
+  trace.sentAt = micros();
+  trace.seq = link.sentSeq(SERIALLINK_SETPOINT);
+}
+
+void fillSensors(TelemetryFrame &frame) {
+  if (mineDetected) frame.flags |= TELEMETRY_FLAG_MINE;
+  if (setpoint.linear || setpoint.angular) frame.flags |= TELEMETRY_FLAG_MOVING;
+  memcpy(frame.sensors.range, ranges, sizeof(ranges));
+}
+
+void fillHealth(TelemetryFrame &frame) {
+  frame.health.freeHeap = ESP.getFreeHeap();
+  frame.health.loopsPerSecond = loopsPerSecond;
+  // dropped and batch are per client, filled in by queueFrame()
+  frame.health.clients = webSocket.connectedClients();
+}
+
+// JSON fallback: one text message per sample
+template<size_t N> void telemetryJson(const TelemetryFrame &frame, FrameBuilder<N> &json) {
+  json.reset();
+  json.beginObject();
+  json.field("stream", frame.stream < TELEMETRY_STREAMS ? streams[frame.stream].name : "trace");
+  json.field("seq", frame.seq);
+  json.field("t", frame.timestamp);
+  if (frame.stream == TELEMETRY_STREAM_POSE) {
+    json.field("x", frame.pose.x, 3);
+    json.field("y", frame.pose.y, 3);
+    json.field("heading", frame.pose.heading, 3);
+  } else if (frame.stream == TELEMETRY_STREAM_SENSORS) {
+    json.field("mine", (frame.flags & TELEMETRY_FLAG_MINE) ? 1 : 0);
+    json.field("front", frame.sensors.range[0]);
+    json.field("left", frame.sensors.range[1]);
+    json.field("right", frame.sensors.range[2]);
+  } else if (frame.stream == TELEMETRY_STREAM_TRACE) {
+    json.field("id", frame.trace.id);
+    json.field("origin", frame.trace.origin);
+    json.field("bridge", frame.trace.bridge);
+    json.field("uart", frame.trace.uart);
+    json.field("uno", frame.trace.uno);
+  } else {
+    json.field("heap", frame.health.freeHeap);
+    json.field("lps", frame.health.loopsPerSecond);
+    json.field("dropped", frame.health.dropped);
+    json.field("batch", frame.health.batch);
+    json.field("clients", frame.health.clients);
+  }
+  json.endObject();
+}
+
+// Fresh telemetry state for a client that just connected
+void resetClient(uint8_t client) {
+  TelemetryClient &c = clients[client];
+  memset(&c, 0, sizeof(c) - sizeof(c.queue));
+  c.batchLimit = 1;
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < TELEMETRY_STREAMS; i++) {
+    c.hz[i] = streams[i].hz;
+    c.nextDue[i] = now;
+  }
+}
+
+// Append a frame to a client's queue, dropping the oldest one when it is full
+void queueFrame(TelemetryClient &c, const TelemetryFrame &frame) {
+  if (c.count == TELEMETRY_BATCH_MAX) {
+    memmove(&c.queue.frames[0], &c.queue.frames[1], (TELEMETRY_BATCH_MAX - 1) * sizeof(TelemetryFrame));
+    c.count--;
+    c.oldest = c.queue.frames[0].timestamp;
+    c.dropped++;
+  }
+  TelemetryFrame &queued = c.queue.frames[c.count];
+  queued = frame;
+  if (frame.stream == TELEMETRY_STREAM_HEALTH) {
+    queued.health.dropped = c.dropped;
+    queued.health.batch = c.batchLimit;
+  }
+  if (!c.count) c.oldest = frame.timestamp;
+  c.count++;
+}
+
+// Send a client's queue in its negotiated format. Binary clients get all
+// frames in one BIN message; JSON clients only the newest sample of each
+// stream, so the fallback cannot swamp the link. A JSON sample is built once,
+// in place, however many clients it goes to. Returns the time spent blocked.
+uint32_t flushClient(uint8_t client) {
+  TelemetryClient &c = clients[client];
+  uint32_t started = micros();
+  if (c.binary) {
+    webSocket.sendBIN(client, (uint8_t *)&c.queue, c.count * sizeof(TelemetryFrame), true);
+    c.linkBytes += c.count * sizeof(TelemetryFrame);
+  } else {
+    const TelemetryFrame *newest[TELEMETRY_STREAMS] = { 0 };
+    for (uint8_t i = 0; i < c.count; i++) newest[c.queue.frames[i].stream] = &c.queue.frames[i];
+    for (uint8_t stream = 0; stream < TELEMETRY_STREAMS; stream++) {
+      if (!newest[stream]) continue;
+      FrameBuilder<TELEMETRY_JSON_MAX> &json = jsonSamples[stream];
+      // health carries per-client fields, so it is never shared
+      if (stream == TELEMETRY_STREAM_HEALTH || jsonSeq[stream] != newest[stream]->seq + 1) {
+        telemetryJson(*newest[stream], json);
+        jsonSeq[stream] = stream == TELEMETRY_STREAM_HEALTH ? 0 : newest[stream]->seq + 1;
+      }
+      if (json.overflowed()) continue;
+      webSocket.sendTXT(client, json.frame(), json.length(), true);
+      c.linkBytes += json.length();
+    }
+  }
+  c.sent += c.count;
+  c.count = 0;
+  uint32_t blocked = micros() - started;
+  c.blocked += blocked;
+  return blocked;
+}
+
+void sendReply(uint8_t client) {
+  if (!reply.overflowed()) webSocket.sendTXT(client, reply.frame(), reply.length(), true);
+}
+
+// Sample the streams due for any client, once, and queue the frame for each
+// of those clients. Then flush at most one client whose queue is full or old
+// enough, taking clients in turn, so the loop gets back to commands and the
+// UART between two sends. A send that blocks means that client's TCP buffer
+// is full: its batch limit doubles (fewer, larger messages) and its sends
+// pause for as long as the link, at the rate it managed since the previous
+// blocked send, needs to carry a full queue. Samples
+// taken meanwhile replace its oldest queued frames instead of stalling the
+// loop. Both back off again after a run of sends that went through without
+// blocking. Other clients are not affected.
+void serviceTelemetry() {
+  uint32_t now = micros();
+
+  for (uint8_t i = 0; i < TELEMETRY_STREAMS; i++) {
+    TelemetryFrame frame;
+    bool sampled = false;
+    for (uint8_t client = 0; client < WEBSOCKETS_SERVER_CLIENT_MAX; client++) {
+      TelemetryClient &c = clients[client];
+      if (!webSocket.clientIsConnected(client) || !c.hz[i] || (int32_t)(now - c.nextDue[i]) < 0) continue;
+      uint32_t period = 1000000UL / c.hz[i];
+      c.nextDue[i] += period;
+      if ((int32_t)(now - c.nextDue[i]) >= 0) c.nextDue[i] = now + period; // fell behind, skip missed samples
+
+      if (!sampled) {
+        memset(&frame, 0, sizeof(frame));
+        frame.magic = TELEMETRY_MAGIC;
+        frame.version = TELEMETRY_VERSION;
+        frame.stream = i;
+        frame.seq = streams[i].seq++;
+        frame.timestamp = now;
+        streams[i].fill(frame);
+        sampled = true;
+      }
+      queueFrame(c, frame);
+    }
+  }
+
+  for (uint8_t n = 0; n < WEBSOCKETS_SERVER_CLIENT_MAX; n++) {
+    uint8_t client = (flushNext + n) % WEBSOCKETS_SERVER_CLIENT_MAX;
+    TelemetryClient &c = clients[client];
+    if (!c.count || (int32_t)(now - c.holdUntil) < 0) continue;
+    if (c.count < c.batchLimit && now - c.oldest < TELEMETRY_LATENCY_MAX_US) continue;
+
+    uint32_t blocked = flushClient(client);
+    if (blocked > TELEMETRY_SEND_BUDGET_US) {
+      // The TCP buffer was full at the last blocked send and is full again,
+      // so what went out in between is what the link carried. Pause long
+      // enough for it to carry a full queue. The first time there is no
+      // measure yet: the buffer started out empty.
+      uint32_t elapsed = micros() - c.linkSince;
+      uint32_t drain = c.linkSince && c.linkBytes ? (uint64_t)elapsed * sizeof(c.queue.frames) / c.linkBytes
+                                                  : TELEMETRY_HOLD_MAX_US;
+      if (c.batchLimit < TELEMETRY_BATCH_MAX) c.batchLimit *= 2;
+      c.holdTime = constrain(max(c.holdTime, drain), 0UL, (uint32_t)TELEMETRY_HOLD_MAX_US);
+      c.linkSince = micros();
+      c.linkBytes = 0;
+      c.holdUntil = micros() + c.holdTime;
+      c.fastFlushes = 0;
+    } else if (++c.fastFlushes >= TELEMETRY_RELAX_FLUSHES) {
+      if (c.batchLimit > 1) c.batchLimit /= 2;
+      c.holdTime /= 2;
+      c.fastFlushes = 0;
+    }
+    flushNext = client + 1;
+    return;
+  }
+}
+
+// The Uno has written the traced setpoint to the motors: tell the client that
+// sent it how long each hop from here on took. The UART hop is half the
+// round trip less the Uno's time; the trace frame goes out straight away, not
+// through the telemetry queue, so the client's round trip is not inflated.
+void sendTrace(uint16_t unoMicros) {
+  static struct __attribute__((packed)) {
+    uint8_t header[WEBSOCKETS_MAX_HEADER_SIZE];
+    TelemetryFrame frame;
+  } message;
+  static uint32_t traceSeq = 0;
+
+  uint32_t now = micros();
+  TelemetryFrame &frame = message.frame;
+  memset(&frame, 0, sizeof(frame));
+  frame.magic = TELEMETRY_MAGIC;
+  frame.version = TELEMETRY_VERSION;
+  frame.stream = TELEMETRY_STREAM_TRACE;
+  frame.seq = traceSeq++;
+  frame.timestamp = now;
+  frame.trace.origin = trace.origin;
+  frame.trace.id = trace.id;
+  frame.trace.bridge = min(trace.sentAt - trace.receivedAt, (uint32_t)0xFFFF);
+  uint32_t roundTrip = now - trace.sentAt;
+  frame.trace.uart = roundTrip > unoMicros ? min((roundTrip - unoMicros) / 2, (uint32_t)0xFFFF) : 0;
+  frame.trace.uno = unoMicros;
+  trace.active = false;
+
+  if (!webSocket.clientIsConnected(trace.client)) return;
+  if (clients[trace.client].binary) {
+    webSocket.sendBIN(trace.client, (uint8_t *)&message, sizeof(frame), true);
+  } else {
+    telemetryJson(frame, reply);
+    sendReply(trace.client);
+  }
+}
+
+// {"stream": "pose", "hz": N} -> answer with the rate actually applied,
+// for the requesting client only
+void setStreamRate(uint8_t client, const char *name, uint8_t nameLength, long hz) {
+  TelemetryClient &c = clients[client];
+  for (uint8_t i = 0; i < TELEMETRY_STREAMS; i++) {
+    if (strlen(streams[i].name) != nameLength || memcmp(name, streams[i].name, nameLength)) continue;
+    c.hz[i] = constrain(hz, 0, TELEMETRY_RATE_MAX);
+    c.nextDue[i] = micros();
+
+    reply.reset();
+    reply.beginObject();
+    reply.field("stream", streams[i].name);
+    reply.field("hz", c.hz[i]);
+    reply.endObject();
+    sendReply(client);
+    return;
+  }
+}
+
+// {"tasks": 1} -> the Uno's scheduler statistics:
+// {"tasks": [{"name": "odom", "runs": N, "wcet": us, "overruns": N, "skipped": N}, ...]}
+void sendUnoTasks(uint8_t client) {
+  reply.reset();
+  reply.beginObject();
+  reply.key("tasks");
+  reply.beginArray();
+  for (uint8_t i = 0; i < unoTaskCount; i++) {
+    const SerialLinkTask &task = unoTasks[i];
+    reply.beginObject();
+    reply.field("name", task.name, strnlen(task.name, sizeof(task.name)));
+    reply.field("runs", task.runs);
+    reply.field("wcet", task.wcet);
+    reply.field("overruns", task.overruns);
+    reply.field("skipped", task.skipped);
+    reply.endObject();
+  }
+  reply.endArray();
+  reply.endObject();
+  sendReply(client);
+}
+
+// {"clients": 1} -> telemetry state of every connected client:
+// {"clients": [{"id": N, "format": "binary"|"json", "pose": hz, "sensors": hz, "health": hz,
+//               "queued": N, "batch": N, "sent": N, "dropped": N, "blocked": ms}, ...]}
+void sendClients(uint8_t client) {
+  reply.reset();
+  reply.beginObject();
+  reply.key("clients");
+  reply.beginArray();
+  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+    if (!webSocket.clientIsConnected(i)) continue;
+    const TelemetryClient &c = clients[i];
+    reply.beginObject();
+    reply.field("id", i);
+    reply.field("format", c.binary ? "binary" : "json");
+    for (uint8_t stream = 0; stream < TELEMETRY_STREAMS; stream++) reply.field(streams[stream].name, c.hz[stream]);
+    reply.field("queued", c.count);
+    reply.field("batch", c.batchLimit);
+    reply.field("sent", c.sent);
+    reply.field("dropped", c.dropped);
+    reply.field("blocked", c.blocked / 1000);
+    reply.endObject();
+  }
+  reply.endArray();
+  reply.endObject();
+  sendReply(client);
+}
+
+// Binary drive command: forward the client's setpoint to the Uno
+void handleCommand(uint8_t client, const uint8_t *payload, size_t length) {
+  if (length != sizeof(TelemetryCommand)) return;
+  TelemetryCommand command;
+  memcpy(&command, payload, sizeof(command));
+  if (command.magic != TELEMETRY_COMMAND_MAGIC || command.version != TELEMETRY_VERSION) return;
+  if (command.type != TELEMETRY_COMMAND_SETPOINT) return;
+  sendSetpoint(command.linear, command.angular);
+
+  trace.active = true;
+  trace.sent = false;
+  trace.client = client;
+  trace.id = command.id;
+  trace.origin = command.origin;
+  trace.receivedAt = micros();
+}
+
+// {"format": "binary"|"json", "version": N} -> answer with the format actually used
+void negotiateFormat(uint8_t client, const char *format, uint8_t formatLength, long version) {
+  clients[client].binary = formatLength == 6 && !memcmp(format, "binary", 6) && version == TELEMETRY_VERSION;
+
+  reply.reset();
+  reply.beginObject();
+  reply.field("format", clients[client].binary ? "binary" : "json");
+  reply.field("version", TELEMETRY_VERSION);
+  reply.endObject();
+  sendReply(client);
+}
+
+// Text commands are JSON objects of string and integer values. They are
+// scanned in place: a field points into the payload, nothing is copied or
+// allocated, and keys and commands are told apart by a switch on length and
+// first character instead of string compares.
+#define COMMAND_PAIRS_MAX   8       // key/value pairs scanned per message
+#define COMMAND_NUMBER_MAX  65535L  // larger magnitudes reject the message; no command takes one (hz is clamped to TELEMETRY_RATE_MAX)
+
+enum CommandKey { KEY_UNKNOWN, KEY_CMD, KEY_FORMAT, KEY_VERSION, KEY_STREAM, KEY_HZ, KEY_TASKS, KEY_CLIENTS, KEY_COUNT };
+
+struct CommandField {
+  const char *text;     // string value, escapes not decoded; 0 for numbers
+  uint8_t length;
+  long number;          // number value (true = 1, false/null = 0)
+};
+
+CommandKey commandKey(const char *key, uint8_t length) {
+  CommandKey candidate = KEY_UNKNOWN;
+  const char *name = "";
+  switch (length) {
+    case 2: candidate = KEY_HZ; name = "hz"; break;
+    case 3: candidate = KEY_CMD; name = "cmd"; break;
+    case 5: candidate = KEY_TASKS; name = "tasks"; break;
+    case 6:
+      if (key[0] == 'f') { candidate = KEY_FORMAT; name = "format"; }
+      else { candidate = KEY_STREAM; name = "stream"; }
+      break;
+    case 7:
+      if (key[0] == 'v') { candidate = KEY_VERSION; name = "version"; }
+      else { candidate = KEY_CLIENTS; name = "clients"; }
+      break;
+  }
+  return candidate != KEY_UNKNOWN && !memcmp(key, name, length) ? candidate : KEY_UNKNOWN;
+}
+
+struct DriveCommand {
+  const char *name;
+  int16_t linear;       // mm/s
+  int16_t angular;      // mrad/s
+};
+
+const DriveCommand driveCommands[] = {
+  { "forward",  DRIVE_LINEAR,  0 },
+  { "backward", -DRIVE_LINEAR, 0 },
+  { "left",     0,             DRIVE_ANGULAR },
+  { "right",    0,             -DRIVE_ANGULAR },
+  { "none",     0,             0 },
+};
+
+const DriveCommand *driveCommand(const char *name, uint8_t length) {
+  const DriveCommand *candidate = 0;
+  switch (length) {
+    case 4: candidate = &driveCommands[name[0] == 'l' ? 2 : 4]; break;
+    case 5: candidate = &driveCommands[3]; break;
+    case 7: candidate = &driveCommands[0]; break;
+    case 8: candidate = &driveCommands[1]; break;
+  }
+  return candidate && !memcmp(name, candidate->name, length) ? candidate : 0;
+}
+
+const char *skipSpace(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+  return p;
+}
+
+// Scan one string (p at the opening quote); returns the character after the closing quote, 0 if malformed
+const char *scanString(const char *p, const char *end, const char **text, uint8_t *length) {
+  const char *start = ++p;
+  while (p < end && *p != '"') p += (*p == '\\') ? 2 : 1;
+  if (p >= end || p - start > 255) return 0;
+  *text = start;
+  *length = p - start;
+  return p + 1;
+}
+
+// Fill fields[] by key from a flat JSON object; false if the payload is not one
+bool scanCommand(const uint8_t *payload, size_t length, CommandField *fields, bool *present) {
+  const char *p = (const char *)payload, *end = p + length;
+  p = skipSpace(p, end);
+  if (p == end || *p++ != '{') return false;
+  p = skipSpace(p, end);
+  if (p < end && *p == '}') return true;
+
+  for (uint8_t count = 0; count < COMMAND_PAIRS_MAX; count++) {
+    const char *keyText;
+    uint8_t keyLength;
+    if (p == end || *p != '"' || !(p = scanString(p, end, &keyText, &keyLength))) return false;
+    p = skipSpace(p, end);
+    if (p == end || *p++ != ':') return false;
+    p = skipSpace(p, end);
+    if (p == end) return false;
+
+    CommandField field = { 0, 0, 0 };
+    if (*p == '"') {
+      if (!(p = scanString(p, end, &field.text, &field.length))) return false;
+    } else if (*p == '[' || *p == '{') {
+      // nested value of a field we do not use: skip it, brackets balanced
+      uint8_t depth = 0;
+      do {
+        if (*p == '"') {
+          const char *text;
+          uint8_t textLength;
+          if (!(p = scanString(p, end, &text, &textLength))) return false;
+          continue;
+        }
+        if (*p == '[' || *p == '{') depth++;
+        else if (*p == ']' || *p == '}') depth--;
+        p++;
+      } while (depth && p < end);
+      if (depth) return false;
+    } else if (*p == 't' || *p == 'f' || *p == 'n') {
+      field.number = *p == 't';
+      while (p < end && *p >= 'a' && *p <= 'z') p++;
+    } else {
+      bool negative = *p == '-';
+      if (negative) p++;
+      if (p == end || *p < '0' || *p > '9') return false;
+      while (p < end && *p >= '0' && *p <= '9') {
+        field.number = field.number * 10 + (*p++ - '0');
+        if (field.number > COMMAND_NUMBER_MAX) return false;
+      }
+      while (p < end && (*p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-' || (*p >= '0' && *p <= '9'))) p++;
+      if (negative) field.number = -field.number;
+    }
+    CommandKey key = commandKey(keyText, keyLength);
+    if (key != KEY_UNKNOWN) {
+      fields[key] = field;
+      present[key] = true;
+    }
+
+    p = skipSpace(p, end);
+    if (p == end) return false;
+    if (*p == '}') return true;
+    if (*p++ != ',') return false;
+    p = skipSpace(p, end);
+  }
+  return false;
+}
+
+void handleText(uint8_t client, const uint8_t *payload, size_t length) {
+  CommandField fields[KEY_COUNT];
+  bool present[KEY_COUNT] = { false };
+  if (!scanCommand(payload, length, fields, present)) return;
+
+  if (present[KEY_FORMAT] && fields[KEY_FORMAT].text) {
+    negotiateFormat(client, fields[KEY_FORMAT].text, fields[KEY_FORMAT].length,
+                    present[KEY_VERSION] ? fields[KEY_VERSION].number : 0);
+  } else if (present[KEY_TASKS]) {
+    sendUnoTasks(client);
+  } else if (present[KEY_CLIENTS]) {
+    sendClients(client);
+  } else if (present[KEY_STREAM] && fields[KEY_STREAM].text) {
+    setStreamRate(client, fields[KEY_STREAM].text, fields[KEY_STREAM].length,
+                  present[KEY_HZ] ? fields[KEY_HZ].number : 0);
+  } else if (present[KEY_CMD] && fields[KEY_CMD].text) {
+    const DriveCommand *command = driveCommand(fields[KEY_CMD].text, fields[KEY_CMD].length);
+    if (command) sendSetpoint(command->linear, command->angular);
   }
 }
 
 void webSocketEvent(uint8_t client, WStype_t type, uint8_t * payload, size_t length) {
   switch(type) {
     case WStype_DISCONNECTED:
+      clients[client].count = 0;
       // Serial.printf("[%u] Disconnected!\n", client);
       break;
       
     case WStype_CONNECTED:
       {
+        resetClient(client);
         IPAddress ip = webSocket.remoteIP(client);
         // Serial.printf("[%u] Connected from %d.%d.%d.%d\n", client, ip[0], ip[1], ip[2], ip[3]);
       }
       break;
+
+    case WStype_BIN:
+      handleCommand(client, payload, length);
+      break;
       
     case WStype_TEXT:
-      {
-        // Parse JSON command
-        StaticJsonDocument<200> doc;
-        DeserializationError error = deserializeJson(doc, payload, length);
-        
-        if (error) {
-          Serial.print(F("deserializeJson() failed: "));
-          Serial.println(error.f_str());
-          return;
-        }
-        
-        // Check if the command field exists
-        if (doc.containsKey("cmd")) {
-          String command = doc["cmd"];
-          // Serial.println("Received cmd: " + command);
-          
-          if (command == "forward") {
-            Serial.println("f");
-          } else if (command == "backward") {
-            Serial.println("b");
-          } else if (command == "left") {
-            Serial.println("l");
-          } else if (command == "right") {
-            Serial.println("r");
-          } else if (command == "none") {
-            Serial.println('s');
-          } else {
-            Serial.println("Unknown command: " + command);
-          }
-        } else {
-          Serial.println("Invalid JSON: missing 'cmd`' field");
-        }
-      }
+      handleText(client, payload, length);
       break;
   }
 }
@@ -0,0 +1,68 @@
+// Burst X/Y/Z word reads and writes, and calibration on a failing bus (native env)
+//
+//   pio test -e native -f test_axis_words
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU6050Sim.h>
+#include <unity.h>
+
+#include "MPU6050.h"
+
+static MPU6050 mpu;
+
+void setUp() {
+    NativeMPU.powerOnReset();
+    NativeMPU.begin(Wire, 2);
+}
+
+void tearDown() {
+}
+
+void test_packed_words_round_trip() {
+    const int16_t offsets[3] = { -1234, 0, 32767 };
+    mpu.setAxisWords(MPU6050_RA_XG_OFFS_USRH, offsets);
+    int16_t read[3] = { 0, 0, 0 };
+    TEST_ASSERT_TRUE(mpu.getAxisWords(MPU6050_RA_XG_OFFS_USRH, read));
+    TEST_ASSERT_EQUAL_MEMORY(offsets, read, sizeof(read));
+    TEST_ASSERT_EQUAL(0xFB, NativeMPU.getRegister(MPU6050_RA_XG_OFFS_USRH));
+    TEST_ASSERT_EQUAL(0x2E, NativeMPU.getRegister(MPU6050_RA_XG_OFFS_USRH + 1));
+}
+
+void test_stride_three_skips_the_byte_between_words() {
+    for (uint8_t i = 0; i < 8; i++) NativeMPU.setRegister(0x77 + i, 0x10 + i);
+    int16_t read[3];
+    TEST_ASSERT_TRUE(mpu.getAxisWords(0x77, read, 3));
+    TEST_ASSERT_EQUAL_HEX16(0x1011, read[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x1314, read[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x1617, read[2]);
+}
+
+void test_failed_read_leaves_data_unchanged() {
+    Wire.detach(MPU6050_DEFAULT_ADDRESS);
+    int16_t read[3] = { 11, 22, 33 };
+    TEST_ASSERT_FALSE(mpu.getAxisWords(MPU6050_RA_ACCEL_XOUT_H, read));
+    TEST_ASSERT_EQUAL(11, read[0]);
+    TEST_ASSERT_EQUAL(22, read[1]);
+    TEST_ASSERT_EQUAL(33, read[2]);
+}
+
+void test_calibration_without_a_device_returns() {
+    Wire.detach(MPU6050_DEFAULT_ADDRESS);
+    uint32_t before = micros();
+    mpu.CalibrateGyro(6);
+    // gives up at the first offset read instead of running 600 PI steps on nothing
+    TEST_ASSERT_LESS_OR_EQUAL(10000, micros() - before);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_packed_words_round_trip);
+    RUN_TEST(test_stride_three_skips_the_byte_between_words);
+    RUN_TEST(test_failed_read_leaves_data_unchanged);
+    RUN_TEST(test_calibration_without_a_device_returns);
+    UNITY_END();
+}
+
+void loop() {
+}
@@ -0,0 +1,84 @@
+// DMP firmware upload and its CRC verification on the simulated MPU6050 (native env)
+//
+//   pio test -e native -f test_dmp_upload
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU6050Sim.h>
+#include <unity.h>
+
+#include "MPU6050_6Axis_MotionApps20.h"
+
+static MPU6050 mpu;
+
+// CRC-16/XMODEM, bit by bit, independent of the one in MPU6050.cpp
+static uint16_t crc16(const uint8_t *data, uint16_t length) {
+    uint16_t crc = 0;
+    while (length--) {
+        crc ^= (uint16_t)pgm_read_byte(data++) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+void setUp() {
+    NativeMPU.powerOnReset();
+    NativeMPU.begin(Wire, 2);
+}
+
+void tearDown() {
+}
+
+void test_image_crcs_match_the_images() {
+    TEST_ASSERT_EQUAL_HEX16(MPU6050_MotionApps20::IMAGE_CRC, crc16(MPU6050_MotionApps20::image, MPU6050_MotionApps20::IMAGE_SIZE));
+    TEST_ASSERT_EQUAL_HEX16(MPU6050_MotionApps612::IMAGE_CRC, crc16(MPU6050_MotionApps612::image, MPU6050_MotionApps612::IMAGE_SIZE));
+    TEST_ASSERT_EQUAL_HEX16(MPU6050_MotionApps41::IMAGE_CRC, crc16(MPU6050_MotionApps41::image, MPU6050_MotionApps41::IMAGE_SIZE));
+}
+
+void test_upload_lands_across_banks() {
+    const uint16_t size = MPU6050_MotionApps20::IMAGE_SIZE;
+    TEST_ASSERT_TRUE(mpu.writeProgMemoryBlock(MPU6050_MotionApps20::image, size, 0, 0, false));
+    TEST_ASSERT_EQUAL_MEMORY(MPU6050_MotionApps20::image, NativeMPU.memory(), size);
+    TEST_ASSERT_TRUE(mpu.verifyMemoryBlock(MPU6050_MotionApps20::IMAGE_CRC, size));
+}
+
+void test_verify_rejects_a_changed_byte() {
+    const uint16_t size = MPU6050_MotionApps20::IMAGE_SIZE;
+    TEST_ASSERT_TRUE(mpu.writeProgMemoryBlock(MPU6050_MotionApps20::image, size, 0, 0, false));
+    uint8_t flipped = MPU6050_MotionApps20::image[700] ^ 0x10;
+    TEST_ASSERT_TRUE(mpu.writeMemoryBlock(&flipped, 1, 700 / 256, 700 % 256, false));
+    TEST_ASSERT_FALSE(mpu.verifyMemoryBlock(MPU6050_MotionApps20::IMAGE_CRC, size));
+}
+
+void test_verify_fails_when_the_readback_fails() {
+    const uint8_t zeros[64] = { 0 };
+    TEST_ASSERT_TRUE(mpu.writeMemoryBlock(zeros, sizeof(zeros), 3, 0));
+    Wire.detach(MPU6050_DEFAULT_ADDRESS);
+    // a CRC over a stale buffer must not pass for the block
+    TEST_ASSERT_FALSE(mpu.verifyMemoryBlock(crc16(zeros, sizeof(zeros)), sizeof(zeros), 3, 0));
+}
+
+void test_verified_write_of_a_small_block() {
+    const uint8_t block[] = { 0x01, 0x02, 0x00, 0xFF, 0x7E };
+    // straddles the bank 1 / bank 2 boundary
+    TEST_ASSERT_TRUE(mpu.writeMemoryBlock(block, sizeof(block), 1, 254));
+    TEST_ASSERT_EQUAL_MEMORY(block, NativeMPU.memory() + 510, sizeof(block));
+}
+
+void test_dmp_initialize_succeeds() {
+    TEST_ASSERT_EQUAL(0, mpu.dmpInitialize());
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_image_crcs_match_the_images);
+    RUN_TEST(test_upload_lands_across_banks);
+    RUN_TEST(test_verify_rejects_a_changed_byte);
+    RUN_TEST(test_verify_fails_when_the_readback_fails);
+    RUN_TEST(test_verified_write_of_a_small_block);
+    RUN_TEST(test_dmp_initialize_succeeds);
+    UNITY_END();
+}
+
+void loop() {
+}
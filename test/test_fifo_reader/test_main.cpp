@@ -0,0 +1,132 @@
+// MPU6050_FIFOReader on the simulated MPU6050 (native env)
+//
+//   pio test -e native -f test_fifo_reader
+//
+// Packets are scripted straight into the sim's FIFO, every byte of packet n
+// set to n, so a packet mixed from two reads shows up as non-uniform bytes.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU6050Sim.h>
+#include <MPU6050_FIFOReader.h>
+#include <unity.h>
+
+#define TEST_INT_PIN        2   // where NativeMain wires the sim's INT
+#define TEST_PACKET_SIZE    42  // MotionApps 2.0, two slices over a 32-byte Wire buffer
+
+static MPU6050 mpu;
+static MPU6050_FIFOReader reader(mpu, TEST_PACKET_SIZE);
+
+static void queuePacket(uint8_t id) {
+    uint8_t data[TEST_PACKET_SIZE];
+    memset(data, id, sizeof(data));
+    NativeMPU.pushFIFO(data, sizeof(data));
+    NativeBoard::raiseInterrupt(TEST_INT_PIN);
+}
+
+static void assertPacket(uint8_t id, const MPU6050_FIFOPacket *packet) {
+    TEST_ASSERT_NOT_NULL(packet);
+    TEST_ASSERT_EACH_EQUAL_UINT8(id, packet->data, TEST_PACKET_SIZE);
+}
+
+// poll() until n more packets are complete
+static void completePackets(uint8_t n) {
+    for (uint8_t calls = 0; n && calls < 50; calls++) if (reader.poll()) n--;
+    TEST_ASSERT_EQUAL(0, n);
+}
+
+void setUp() {
+    NativeMPU.powerOnReset();
+    NativeMPU.setPacketSize(TEST_PACKET_SIZE);
+    reader.begin(TEST_INT_PIN);
+    reader.interruptCount = reader.transactions = reader.packetsRead = reader.packetsDropped = reader.overflows = 0;
+}
+
+void tearDown() {
+    reader.end();
+}
+
+void test_idle_poll_is_free() {
+    uint32_t before = Wire.transactions;
+    for (uint8_t i = 0; i < 10; i++) TEST_ASSERT_FALSE(reader.poll());
+    TEST_ASSERT_EQUAL(before, Wire.transactions);
+    TEST_ASSERT_EQUAL(0, reader.available());
+}
+
+void test_packet_read_in_slices() {
+    queuePacket(7);
+    TEST_ASSERT_FALSE(reader.poll());   // FIFO count
+    TEST_ASSERT_FALSE(reader.poll());   // first 32 bytes
+    TEST_ASSERT_EQUAL(0, reader.available());
+    TEST_ASSERT_TRUE(reader.poll());    // last 10 bytes
+    MPU6050_FIFOPacket packet;
+    TEST_ASSERT_TRUE(reader.read(&packet));
+    assertPacket(7, &packet);
+    TEST_ASSERT_FALSE(reader.read(&packet));
+    TEST_ASSERT_EQUAL(3, reader.transactions);
+}
+
+void test_ring_keeps_order_across_wrap() {
+    MPU6050_FIFOPacket packet;
+    for (uint8_t id = 1; id <= 3 * MPU6050_FIFOREADER_SLOTS; id++) {
+        queuePacket(id);
+        completePackets(1);
+        TEST_ASSERT_TRUE(reader.read(&packet));
+        assertPacket(id, &packet);
+    }
+    TEST_ASSERT_EQUAL(0, reader.packetsDropped);
+}
+
+void test_full_ring_never_exposes_a_partial_packet() {
+    for (uint8_t id = 1; id <= MPU6050_FIFOREADER_SLOTS; id++) queuePacket(id);
+    completePackets(MPU6050_FIFOREADER_SLOTS);
+    TEST_ASSERT_EQUAL(MPU6050_FIFOREADER_SLOTS, reader.available());
+
+    uint8_t newest = MPU6050_FIFOREADER_SLOTS + 1;
+    queuePacket(newest);
+    TEST_ASSERT_FALSE(reader.poll());   // FIFO count
+    TEST_ASSERT_FALSE(reader.poll());   // first slice of the new packet, oldest dropped for it
+    TEST_ASSERT_EQUAL(1, reader.packetsDropped);
+    TEST_ASSERT_EQUAL(MPU6050_FIFOREADER_SLOTS - 1, reader.available());
+
+    // read between the slices: the oldest survivor, whole
+    assertPacket(2, reader.peek());
+    MPU6050_FIFOPacket packet;
+    TEST_ASSERT_TRUE(reader.read(&packet));
+    assertPacket(2, &packet);
+
+    TEST_ASSERT_TRUE(reader.poll());    // second slice completes the new packet
+    for (uint8_t id = 3; id <= newest; id++) {
+        TEST_ASSERT_TRUE(reader.read(&packet));
+        assertPacket(id, &packet);
+    }
+    TEST_ASSERT_EQUAL(0, reader.available());
+    TEST_ASSERT_EQUAL(1, reader.packetsDropped);
+}
+
+void test_wrapped_fifo_is_reset() {
+    for (uint8_t id = 1; id <= MPU6050_FIFO_SIZE / TEST_PACKET_SIZE + 1; id++) queuePacket(id);
+    TEST_ASSERT_FALSE(reader.poll());
+    TEST_ASSERT_EQUAL(1, reader.overflows);
+    TEST_ASSERT_EQUAL(0, NativeMPU.fifoCount());
+
+    // back on a packet boundary afterwards
+    queuePacket(9);
+    completePackets(1);
+    MPU6050_FIFOPacket packet;
+    TEST_ASSERT_TRUE(reader.read(&packet));
+    assertPacket(9, &packet);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_poll_is_free);
+    RUN_TEST(test_packet_read_in_slices);
+    RUN_TEST(test_ring_keeps_order_across_wrap);
+    RUN_TEST(test_full_ring_never_exposes_a_partial_packet);
+    RUN_TEST(test_wrapped_fifo_is_reset);
+    UNITY_END();
+}
+
+void loop() {
+}
@@ -0,0 +1,323 @@
+// SerialLink framing (COBS + CRC-16), priorities and loss accounting (native env)
+//
+//   pio test -e native -f test_serial_link
+//
+// Two links on two in-memory ports; deliver() moves what one wrote into the
+// other's receive buffer, optionally after the test has damaged it.
+
+#include <Arduino.h>
+#include <SerialLink.h>
+#include <string>
+#include <unity.h>
+
+struct Received {
+    uint8_t type;
+    uint8_t seq;
+    uint8_t length;
+    uint8_t payload[SERIALLINK_PAYLOAD_MAX];
+};
+
+static Received received[64];
+static uint8_t receivedCount;
+
+static void record(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t length) {
+    if (receivedCount == sizeof(received) / sizeof(received[0])) return;
+    Received &r = received[receivedCount++];
+    r.type = type;
+    r.seq = seq;
+    r.length = length;
+    memcpy(r.payload, payload, length);
+}
+
+static std::string take(HardwareSerial &from) {
+    std::string wire = from.output();
+    from.clearOutput();
+    return wire;
+}
+
+static void deliver(const std::string &wire, HardwareSerial &to, SerialLink &link) {
+    to.inject((const uint8_t *)wire.data(), wire.size());
+    link.poll();
+}
+
+// one frame of the given type and payload, as it goes on the wire
+static std::string frame(uint8_t type, const uint8_t *payload, uint8_t length) {
+    HardwareSerial port;
+    SerialLink link(port);
+    link.send(type, payload, length);
+    link.poll();
+    return take(port);
+}
+
+void setUp() {
+    NativeBoard::reset();
+    receivedCount = 0;
+}
+
+void tearDown() {
+}
+
+void test_crc_check_value() {
+    // CRC-16/CCITT-FALSE of "123456789"
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, serialLinkCrc((const uint8_t *)"123456789", 9));
+}
+
+void test_round_trip_every_length() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    uint8_t payload[SERIALLINK_PAYLOAD_MAX];
+    for (uint8_t length = 0; length <= SERIALLINK_PAYLOAD_MAX; length++) {
+        // zeros, 0xFF and everything between, so COBS has blocks to split
+        for (uint8_t i = 0; i < length; i++) payload[i] = (i % 3 == 0) ? 0 : (uint8_t)(length * 17 + i * 29);
+        TEST_ASSERT_TRUE(a.send(SERIALLINK_POSE, payload, length));
+        a.poll();
+        std::string wire = take(portA);
+        TEST_ASSERT_EQUAL(length + 6, wire.size());
+        TEST_ASSERT_EQUAL(wire.size() - 1, wire.find('\0'));     // the delimiter is the only zero
+        deliver(wire, portB, b);
+        TEST_ASSERT_EQUAL(length + 1, receivedCount);
+        Received &r = received[length];
+        TEST_ASSERT_EQUAL(SERIALLINK_POSE, r.type);
+        TEST_ASSERT_EQUAL(length, r.length);
+        TEST_ASSERT_EQUAL_MEMORY(payload, r.payload, length);
+    }
+    TEST_ASSERT_EQUAL(0, b.crcErrors + b.framingErrors + b.framesLost);
+}
+
+void test_all_zero_payload() {
+    HardwareSerial portB;
+    SerialLink b(portB);
+    b.begin(record);
+    const uint8_t zeros[SERIALLINK_PAYLOAD_MAX] = { 0 };
+    std::string wire = frame(SERIALLINK_SENSORS, zeros, sizeof(zeros));
+    TEST_ASSERT_EQUAL(wire.size() - 1, wire.find('\0'));
+    deliver(wire, portB, b);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL_MEMORY(zeros, received[0].payload, sizeof(zeros));
+}
+
+void test_send_rejects_bad_messages() {
+    HardwareSerial port;
+    SerialLink link(port);
+    uint8_t payload[SERIALLINK_PAYLOAD_MAX + 1] = { 0 };
+    TEST_ASSERT_FALSE(link.send(0, payload, 1));
+    TEST_ASSERT_FALSE(link.send(SERIALLINK_TYPES, payload, 1));
+    TEST_ASSERT_FALSE(link.send(SERIALLINK_POSE, payload, sizeof(payload)));
+    link.poll();
+    TEST_ASSERT_EQUAL(0, port.output().size());
+}
+
+void test_newer_message_replaces_pending_one() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    SerialLinkSetpoint first = { 100, 0 }, second = { 200, -50 };
+    a.send(SERIALLINK_SETPOINT, &first, sizeof(first));
+    TEST_ASSERT_TRUE(a.pending(SERIALLINK_SETPOINT));
+    a.send(SERIALLINK_SETPOINT, &second, sizeof(second));
+    a.poll();
+    TEST_ASSERT_FALSE(a.pending(SERIALLINK_SETPOINT));
+    TEST_ASSERT_EQUAL(1, a.framesReplaced);
+    TEST_ASSERT_EQUAL(1, a.framesSent);
+    deliver(take(portA), portB, b);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL_MEMORY(&second, received[0].payload, sizeof(second));
+}
+
+void test_higher_priority_goes_first() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    uint8_t payload[4] = { 1, 2, 3, 4 };
+    a.send(SERIALLINK_TASK, payload, sizeof(payload));
+    a.send(SERIALLINK_POSE, payload, sizeof(payload));
+    a.send(SERIALLINK_SETPOINT, payload, sizeof(payload));
+    a.poll();
+    deliver(take(portA), portB, b);
+    TEST_ASSERT_EQUAL(3, receivedCount);
+    TEST_ASSERT_EQUAL(SERIALLINK_SETPOINT, received[0].type);
+    TEST_ASSERT_EQUAL(SERIALLINK_POSE, received[1].type);
+    TEST_ASSERT_EQUAL(SERIALLINK_TASK, received[2].type);
+}
+
+void test_full_tx_buffer_defers_frames() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    portA.begin(115200);
+    int room = portA.availableForWrite();
+    uint8_t payload[SERIALLINK_PAYLOAD_MAX];
+    memset(payload, 0x55, sizeof(payload));
+    for (uint8_t type = 1; type < SERIALLINK_TYPES; type++) a.send(type, payload, sizeof(payload));
+    a.poll();
+    TEST_ASSERT_LESS_OR_EQUAL(room, (int)portA.output().size());
+    TEST_ASSERT_TRUE(a.pending(SERIALLINK_TASK));
+
+    // the UART drains, the rest goes out on later polls
+    for (uint8_t i = 0; i < 10; i++) {
+        NativeBoard::advanceMicros(10000);
+        a.poll();
+    }
+    for (uint8_t type = 1; type < SERIALLINK_TYPES; type++) TEST_ASSERT_FALSE(a.pending(type));
+    deliver(take(portA), portB, b);
+    TEST_ASSERT_EQUAL(SERIALLINK_TYPES - 1, receivedCount);
+}
+
+void test_corrupt_frame_is_dropped_and_the_next_one_received() {
+    HardwareSerial portB;
+    SerialLink b(portB);
+    b.begin(record);
+    uint8_t payload[6] = { 10, 20, 30, 40, 50, 60 };
+    std::string bad = frame(SERIALLINK_POSE, payload, sizeof(payload));
+    bad[4] ^= 0x01;
+    deliver(bad, portB, b);
+    TEST_ASSERT_EQUAL(0, receivedCount);
+    TEST_ASSERT_EQUAL(1, b.crcErrors);
+
+    deliver(frame(SERIALLINK_POSE, payload, sizeof(payload)), portB, b);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL_MEMORY(payload, received[0].payload, sizeof(payload));
+}
+
+void test_dropped_byte_resynchronises() {
+    HardwareSerial portB;
+    SerialLink b(portB);
+    b.begin(record);
+    uint8_t payload[8] = { 1, 0, 2, 0, 3, 0, 4, 0 };
+    std::string cut = frame(SERIALLINK_SENSORS, payload, sizeof(payload));
+    cut.erase(3, 1);
+    std::string good = frame(SERIALLINK_SENSORS, payload, sizeof(payload));
+    deliver(cut + good, portB, b);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL(1, b.crcErrors + b.framingErrors);
+    TEST_ASSERT_EQUAL_MEMORY(payload, received[0].payload, sizeof(payload));
+}
+
+void test_overlong_and_short_frames_are_framing_errors() {
+    HardwareSerial portB;
+    SerialLink b(portB);
+    b.begin(record);
+    std::string noise(SERIALLINK_ENCODED_MAX + 10, 'x');
+    noise += '\0';
+    noise += "\x02\x01";    // decodes to two bytes: too short for type, seq and CRC
+    noise += '\0';
+    uint8_t payload[2] = { 7, 7 };
+    deliver(noise + frame(SERIALLINK_POSE, payload, sizeof(payload)), portB, b);
+    TEST_ASSERT_EQUAL(2, b.framingErrors);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+}
+
+void test_unknown_type_is_rejected() {
+    HardwareSerial portB;
+    SerialLink b(portB);
+    b.begin(record);
+    // a well-formed frame of type SERIALLINK_TYPES: build it by hand
+    uint8_t raw[4] = { SERIALLINK_TYPES, 1, 0, 0 };
+    uint16_t crc = serialLinkCrc(raw, 2);
+    raw[2] = crc & 0xFF;
+    raw[3] = crc >> 8;
+    TEST_ASSERT_TRUE(raw[2] && raw[3]);     // no zeros: COBS is one block
+    std::string wire;
+    wire += (char)5;
+    wire.append((const char *)raw, 4);
+    wire += '\0';
+    deliver(wire, portB, b);
+    TEST_ASSERT_EQUAL(0, receivedCount);
+    TEST_ASSERT_EQUAL(1, b.framingErrors);
+}
+
+void test_boot_text_is_closed_by_begin() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    portA.write((const uint8_t *)"boot text\r\n", 11);
+    a.begin(record);
+    uint8_t payload[3] = { 1, 2, 3 };
+    a.send(SERIALLINK_POSE, payload, sizeof(payload));
+    a.poll();
+    deliver(take(portA), portB, b);
+    TEST_ASSERT_EQUAL(1, receivedCount);
+    TEST_ASSERT_EQUAL(SERIALLINK_POSE, received[0].type);
+}
+
+void test_seq_gaps_count_as_lost_frames() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    uint8_t payload[1] = { 0 };
+    for (uint8_t i = 0; i < 5; i++) {
+        payload[0] = i;
+        a.send(SERIALLINK_POSE, payload, 1);
+        a.poll();
+        std::string wire = take(portA);
+        if (i != 1 && i != 2) deliver(wire, portB, b);    // two frames lost on the wire
+    }
+    TEST_ASSERT_EQUAL(3, receivedCount);
+    TEST_ASSERT_EQUAL(2, b.framesLost);
+    TEST_ASSERT_EQUAL(3, b.framesReceived);
+}
+
+void test_seq_wraps_without_loss() {
+    HardwareSerial portA, portB;
+    SerialLink a(portA), b(portB);
+    b.begin(record);
+    uint8_t payload[2] = { 0, 0 };
+    for (uint16_t i = 0; i < 600; i++) {
+        payload[0] = i;
+        payload[1] = i >> 8;
+        a.send(SERIALLINK_SENSORS, payload, sizeof(payload));
+        a.poll();
+        receivedCount = 0;
+        deliver(take(portA), portB, b);
+        TEST_ASSERT_EQUAL(1, receivedCount);
+        TEST_ASSERT_EQUAL((uint8_t)(i + 1), received[0].seq);
+        TEST_ASSERT_EQUAL(a.sentSeq(SERIALLINK_SENSORS), received[0].seq);
+    }
+    TEST_ASSERT_EQUAL(0, b.framesLost);
+    TEST_ASSERT_EQUAL(600, b.framesReceived);
+}
+
+void test_peer_restart_is_not_loss() {
+    HardwareSerial portA, portB;
+    SerialLink b(portB);
+    b.begin(record);
+    uint8_t payload[1] = { 0 };
+    {
+        SerialLink a(portA);
+        for (uint8_t i = 0; i < 20; i++) {
+            a.send(SERIALLINK_POSE, payload, 1);
+            a.poll();
+        }
+        deliver(take(portA), portB, b);
+    }
+    SerialLink restarted(portA);
+    restarted.send(SERIALLINK_POSE, payload, 1);
+    restarted.poll();
+    deliver(take(portA), portB, b);
+    TEST_ASSERT_EQUAL(21, receivedCount);
+    TEST_ASSERT_EQUAL(0, b.framesLost);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_check_value);
+    RUN_TEST(test_round_trip_every_length);
+    RUN_TEST(test_all_zero_payload);
+    RUN_TEST(test_send_rejects_bad_messages);
+    RUN_TEST(test_newer_message_replaces_pending_one);
+    RUN_TEST(test_higher_priority_goes_first);
+    RUN_TEST(test_full_tx_buffer_defers_frames);
+    RUN_TEST(test_corrupt_frame_is_dropped_and_the_next_one_received);
+    RUN_TEST(test_dropped_byte_resynchronises);
+    RUN_TEST(test_overlong_and_short_frames_are_framing_errors);
+    RUN_TEST(test_unknown_type_is_rejected);
+    RUN_TEST(test_boot_text_is_closed_by_begin);
+    RUN_TEST(test_seq_gaps_count_as_lost_frames);
+    RUN_TEST(test_seq_wraps_without_loss);
+    RUN_TEST(test_peer_restart_is_not_loss);
+    UNITY_END();
+}
+
+void loop() {
+}
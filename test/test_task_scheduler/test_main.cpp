@@ -0,0 +1,163 @@
+// Task scheduler: releases, priority order, skipped releases and overruns (native env)
+//
+//   pio test -e native -f test_task_scheduler
+//
+// Time is ArduinoNative's virtual clock: tasks "run" for as long as they
+// advance it. Each micros() read costs it 1 us, so times are checked against
+// the period grid from the first release and run times to within a few us.
+
+#include <Arduino.h>
+#include <task_scheduler.h>
+#include <unity.h>
+
+static char order[32];
+static uint8_t orderLength;
+static unsigned long costA, costB;
+
+static void note(char c) {
+    if (orderLength < sizeof(order) - 1) order[orderLength++] = c;
+    order[orderLength] = 0;
+}
+
+static void runA() {
+    note('a');
+    NativeBoard::advanceMicros(costA);
+}
+
+static void runB() {
+    note('b');
+    NativeBoard::advanceMicros(costB);
+}
+
+static void runC() {
+    note('c');
+}
+
+static Task tasks[3];
+static unsigned long first;     // release of every task after startTasks()
+
+static void table(uint32_t periodA, uint32_t deadlineA, uint32_t periodB, uint32_t deadlineB) {
+    memset(tasks, 0, sizeof(tasks));
+    tasks[0].name = "a";
+    tasks[0].run = runA;
+    tasks[0].period = periodA;
+    tasks[0].deadline = deadlineA;
+    tasks[1].name = "b";
+    tasks[1].run = runB;
+    tasks[1].period = periodB;
+    tasks[1].deadline = deadlineB;
+    tasks[2].name = "c";
+    tasks[2].run = runC;
+    tasks[2].period = 1000;
+    tasks[2].deadline = 1000;
+    startTasks(tasks, 3);
+    first = tasks[0].release;
+}
+
+void setUp() {
+    NativeBoard::reset();
+    orderLength = 0;
+    order[0] = 0;
+    costA = costB = 0;
+}
+
+void tearDown() {
+}
+
+void test_ready_tasks_run_in_table_order() {
+    table(1000, 1000, 1000, 1000);
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL_STRING("abc", order);
+    // nothing is ready again until a period has passed
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL_STRING("abc", order);
+    NativeBoard::advanceMicros(1000);
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL_STRING("abcabc", order);
+}
+
+void test_tasks_run_at_their_own_period() {
+    table(1000, 1000, 5000, 5000);
+    for (uint16_t us = 0; us < 20000; us += 100) {
+        runTasks(tasks, 3);
+        NativeBoard::advanceMicros(100);
+    }
+    unsigned long elapsed = micros() - first;
+    TEST_ASSERT_EQUAL(elapsed / 1000 + 1, tasks[0].runs);
+    TEST_ASSERT_EQUAL(elapsed / 5000 + 1, tasks[1].runs);
+    TEST_ASSERT_EQUAL(0, tasks[0].skipped + tasks[1].skipped);
+    TEST_ASSERT_EQUAL(0, tasks[0].overruns + tasks[1].overruns);
+}
+
+void test_release_is_kept_on_the_period_grid() {
+    table(1000, 1000, 1000, 1000);
+    runTasks(tasks, 3);
+    NativeBoard::advanceMicros(1300);   // late by 300 us, not a full period
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(first + 2000, tasks[0].release);
+    TEST_ASSERT_EQUAL(0, tasks[0].skipped);
+}
+
+void test_missed_releases_are_skipped_not_caught_up() {
+    table(1000, 1000, 1000, 1000);
+    runTasks(tasks, 3);
+    NativeBoard::advanceMicros(4500);   // releases at 1000..4000 due, only one run
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(2, tasks[0].runs);
+    TEST_ASSERT_EQUAL(3, tasks[0].skipped);
+    TEST_ASSERT_EQUAL(first + 5000, tasks[0].release);
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(2, tasks[0].runs);
+}
+
+void test_long_run_is_an_overrun_and_sets_wcet() {
+    table(10000, 2000, 10000, 10000);
+    costA = 2500;
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(1, tasks[0].overruns);
+    uint32_t wcet = tasks[0].wcet;
+    TEST_ASSERT_GREATER_THAN(2499, wcet);
+    TEST_ASSERT_LESS_OR_EQUAL(2510, wcet);
+    costA = 500;
+    NativeBoard::advanceMicros(10000 - 2500);
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(1, tasks[0].overruns);
+    TEST_ASSERT_EQUAL(wcet, tasks[0].wcet);
+}
+
+void test_late_start_counts_towards_the_deadline() {
+    // b runs only 600 us, but starts 700 us after its release behind a
+    table(10000, 10000, 10000, 1000);
+    costA = 700;
+    costB = 600;
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(0, tasks[0].overruns);
+    TEST_ASSERT_EQUAL(1, tasks[1].overruns);
+    TEST_ASSERT_LESS_OR_EQUAL(610, tasks[1].wcet);
+}
+
+void test_a_task_delayed_past_its_period_by_another_is_skipped() {
+    table(1000, 1000, 1000, 1000);
+    costA = 2200;   // a hogs the loop: b and c start 2200 us late
+    runTasks(tasks, 3);
+    TEST_ASSERT_EQUAL(2, tasks[1].skipped);
+    TEST_ASSERT_EQUAL(2, tasks[2].skipped);
+    // measured from the newest release it missed, so not an overrun as well
+    TEST_ASSERT_EQUAL(0, tasks[1].overruns);
+    TEST_ASSERT_EQUAL(first + 3000, tasks[1].release);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ready_tasks_run_in_table_order);
+    RUN_TEST(test_tasks_run_at_their_own_period);
+    RUN_TEST(test_release_is_kept_on_the_period_grid);
+    RUN_TEST(test_missed_releases_are_skipped_not_caught_up);
+    RUN_TEST(test_long_run_is_an_overrun_and_sets_wcet);
+    RUN_TEST(test_late_start_counts_towards_the_deadline);
+    RUN_TEST(test_a_task_delayed_past_its_period_by_another_is_skipped);
+    UNITY_END();
+}
+
+void loop() {
+}